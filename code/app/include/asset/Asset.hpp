@@ -21,6 +21,7 @@ namespace NRenderer
         // ʲ
         vector<ModelItem> modelItems;         // ģб
         vector<NodeItem> nodeItems;           // ڵб
+        vector<InstanceItem> instanceItems;   // ģʵб
         vector<MaterialItem> materialItems;    // б
         vector<TextureItem> textureItems;     // б
         vector<LightItem> lightItems;         // Դб
@@ -37,6 +38,45 @@ namespace NRenderer
         vector<SharedDirectionalLight> directionalLights;  // ƽйб
         vector<SharedSpotLight> spotLights;           // ۹б
 
+        // ʲİ汾ţ޸ʲ£ʱƵScene::version
+        // ȾݴжϻǷʧЧ
+        uint64_t geometryVersion = nextVersion();   // ģͱ任
+        uint64_t materialVersion = nextVersion();   // ʼĲʰ
+        uint64_t textureVersion = nextVersion();    // 
+        uint64_t lightVersion = nextVersion();      // Դ
+
+        // Ǽ޸ģitemΪ޸ĵʲ
+        void markGeometryDirty(Item* item = nullptr) {
+            geometryVersion = nextVersion();
+            if (item) item->version = geometryVersion;
+        }
+
+        // ǲ޸
+        void markMaterialDirty(Item* item = nullptr) {
+            materialVersion = nextVersion();
+            if (item) item->version = materialVersion;
+        }
+
+        // ޸
+        void markTextureDirty(Item* item = nullptr) {
+            textureVersion = nextVersion();
+            if (item) item->version = textureVersion;
+        }
+
+        // ǹԴ޸
+        void markLightDirty(Item* item = nullptr) {
+            lightVersion = nextVersion();
+            if (item) item->version = lightVersion;
+        }
+
+        // ȫʲ޸ģ볡ã
+        void markAllDirty() {
+            markGeometryDirty();
+            markMaterialDirty();
+            markTextureDirty();
+            markLightDirty();
+        }
+
         // ģ
         // ɾģصOpenGLģб
         void clearModel() {
@@ -67,11 +107,13 @@ namespace NRenderer
             }
             modelItems.clear();
             nodeItems.clear();
+            instanceItems.clear();
 
             spheres.clear();
             triangles.clear();
             planes.clear();
             meshes.clear();
+            markGeometryDirty();
         }
 
         // Դ
@@ -83,18 +125,21 @@ namespace NRenderer
             areaLights.clear();
             directionalLights.clear();
             spotLights.clear();
+            markLightDirty();
         }
 
         // 
         // ղб
         void clearMaterial() {
             materialItems.clear();
+            markMaterialDirty();
         }
 
         // 
         // б
         void clearTexture() {
             textureItems.clear();
+            markTextureDirty();
         }
 
         // ΪڵԤõOpenGL
@@ -6,6 +6,8 @@
 // ˳ʲĻṹ
 
 #include <string>
+#include <atomic>
+#include <cstdint>
 
 namespace NRenderer
 {
@@ -13,16 +15,25 @@ namespace NRenderer
     // OpenGLID
     using GlId = unsigned int;
 
+    // µİ汾
+    // 汾ȫֵʲµҲ֮ǰİ汾ظ
+    inline uint64_t nextVersion() {
+        static atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
     // ʲ
     // гʲģ͡ʡԴȣĻ
     struct Item
     {
-        string name;    // ʲ
+        string name;        // ʲ
+        uint64_t version;   // һ޸ʱİ汾
 
         // ĬϹ캯
         // һδʲ
         Item()
             : name      ("undefined")
+            , version   (nextVersion())
         {}
     };
 
@@ -31,6 +31,13 @@ namespace NRenderer
         SharedNode node{nullptr};  // ڵݵָ
         SharedGlDrawData externalDrawData{nullptr};  // ⲿ
     };
+
+    // ģʵʲ
+    // Ԥʱģ͸ڵOpenGLûл
+    struct InstanceItem : public Item
+    {
+        SharedModelInstance instance{nullptr};  // ʵݵָ
+    };
     
 } // namespace NRenderer
 
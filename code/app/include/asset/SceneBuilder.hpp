@@ -21,6 +21,7 @@ namespace NRenderer
         void buildBuffer();
         void buildCamera();
         void buildAmbient();
+        void buildVersion();
         bool success;
     public:
         SceneBuilder(const Asset& asset, const RenderSettings& renderSettings, const AmbientSettings& ambientSettings, const Camera& camera)
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef __NR_NRS_EXPORTER_HPP__
+#define __NR_NRS_EXPORTER_HPP__
+
+// Ƴļͷļ
+// ѵǰʲд.nrsļ֮NrsImporterֱ
+
+#include <string>
+#include "asset/Asset.hpp"
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // NRSļ
+    class NrsExporter
+    {
+    private:
+        string lastErrorInfo;   // һδϢ
+    public:
+        // ʲ
+        // asset: Դʲ
+        // path: ļ·
+        // : Ƿɹ
+        bool exportAsset(const Asset& asset, const string& path);
+
+        // ȡϢ
+        // : һδϢ
+        inline
+        string getErrorInfo() const {
+            return lastErrorInfo;
+        }
+    };
+}
+
+#endif
\ No newline at end of file
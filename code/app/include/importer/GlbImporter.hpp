@@ -0,0 +1,28 @@
+#pragma once
+#ifndef __NR_GLB_IMPORTER_HPP__
+#define __NR_GLB_IMPORTER_HPP__
+
+// glTF 2.0ļͷļ
+// Ƶ.glbļҲJSONı.gltfļ
+
+#include "Importer.hpp"
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // glTFļ
+    // ļڴӳ䷽ʽ򿪣ݴӻͼ鸴ƵС
+    // ÿglTFΪһֻΪģģͣÿͼԪһڵ㣩ÿglTFڵ㵼Ϊģ͵һʵ
+    class GlbImporter: public Importer
+    {
+    public:
+        // glTFļ
+        // asset: Ŀʲ
+        // path: glTFļ·
+        // : Ƿɹ
+        virtual bool import(Asset& asset, const string& path) override;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+#pragma once
+#ifndef __NR_NRS_FORMAT_HPP__
+#define __NR_NRS_FORMAT_HPP__
+
+// Ƴļ.nrsʽ
+// ļļͷֶαɰ64ֽڶķֶɣֵСš
+// ֶڵĴ飨񶥵㡢أ16ֽڶ룬ȡʱ鸴ƣ
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+namespace NRenderer
+{
+    using namespace std;
+
+    namespace Nrs
+    {
+        constexpr char magic[8] = { 'N', 'R', 'S', 'C', 'E', 'N', 'E', '\0' };
+        constexpr uint32_t version = 2;             // ʽ汾ָıʱ
+        constexpr uint32_t minVersion = 1;          // ܶȡ汾汾1ģͼ¼ûпɼ־
+        constexpr size_t sectionAlignment = 64;     // ֶĶ
+        constexpr size_t arrayAlignment = 16;       // ֶĶ
+
+        // ֶͣÿһΣȡʱԲʶķֶ
+        enum class Section : uint32_t
+        {
+            MATERIALS = 1,
+            TEXTURES,
+            MODELS,
+            NODES,
+            SPHERES,
+            TRIANGLES,
+            PLANES,
+            MESHES,
+            LIGHTS,
+            POINT_LIGHTS,
+            AREA_LIGHTS,
+            DIRECTIONAL_LIGHTS,
+            SPOT_LIGHTS,
+            INSTANCES
+        };
+        constexpr size_t sectionTypeCount = size_t(Section::INSTANCES) + 1;
+
+        // ļͷ
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t sectionCount;      // ֶαֶαļͷ֮
+            uint64_t fileSize;          // ļֽڼļǷ񱻽ض
+        };
+        static_assert(sizeof(Header) == 24, "unexpected header layout");
+
+        // ֶα
+        struct SectionEntry
+        {
+            uint32_t type;              // Section
+            uint32_t count;             // ֶеļ¼
+            uint64_t offset;            // ֶļͷƫ
+            uint64_t size;              // ֶֽ
+        };
+        static_assert(sizeof(SectionEntry) == 24, "unexpected section entry layout");
+
+        // ֶд
+        class Writer
+        {
+        private:
+            vector<unsigned char> buffer;
+        public:
+            const vector<unsigned char>& data() const { return buffer; }
+
+            // 0ֱǰλðalignment
+            void align(size_t alignment) {
+                buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, 0);
+            }
+
+            // дƽ͵ֵ
+            template<typename T>
+            void pod(const T& value) {
+                auto p = reinterpret_cast<const unsigned char*>(&value);
+                buffer.insert(buffer.end(), p, p + sizeof(T));
+            }
+
+            // дַȼ
+            void str(const string& s) {
+                pod(uint32_t(s.size()));
+                buffer.insert(buffer.end(), s.begin(), s.end());
+            }
+
+            // д飺ԪӶ
+            template<typename T>
+            void array(const T* values, size_t count) {
+                pod(uint64_t(count));
+                align(arrayAlignment);
+                auto p = reinterpret_cast<const unsigned char*>(values);
+                buffer.insert(buffer.end(), p, p + sizeof(T)*count);
+            }
+
+            template<typename T>
+            void array(const vector<T>& values) {
+                array(values.data(), values.size());
+            }
+        };
+
+        // ֶζȡ
+        // Խʱʧܱǲֵڶһֶκok()
+        class Reader
+        {
+        private:
+            const unsigned char* begin;
+            const unsigned char* p;
+            const unsigned char* end;
+            bool good;
+
+            bool require(size_t n) {
+                if (!good || size_t(end - p) < n) {
+                    good = false;
+                    return false;
+                }
+                return true;
+            }
+        public:
+            Reader(const void* data, size_t size)
+                : begin             (static_cast<const unsigned char*>(data))
+                , p                 (begin)
+                , end               (begin + size)
+                , good              (true)
+            {}
+
+            bool ok() const { return good; }
+
+            void align(size_t alignment) {
+                size_t offset = size_t(p - begin);
+                size_t aligned = (offset + alignment - 1) / alignment * alignment;
+                if (require(aligned - offset)) p = begin + aligned;
+            }
+
+            template<typename T>
+            T pod() {
+                T value{};
+                if (require(sizeof(T))) {
+                    memcpy(&value, p, sizeof(T));
+                    p += sizeof(T);
+                }
+                return value;
+            }
+
+            string str() {
+                auto n = pod<uint32_t>();
+                if (!require(n)) return {};
+                string s(reinterpret_cast<const char*>(p), n);
+                p += n;
+                return s;
+            }
+
+            // ȡλԪ
+            template<typename T>
+            const T* array(size_t& count) {
+                auto n = pod<uint64_t>();
+                align(arrayAlignment);
+                if (!good || n > size_t(end - p) / sizeof(T)) {
+                    good = false;
+                    count = 0;
+                    return nullptr;
+                }
+                auto values = reinterpret_cast<const T*>(p);
+                p += sizeof(T)*n;
+                count = size_t(n);
+                return values;
+            }
+
+            // ȡ鲢鸴Ƶvector
+            template<typename T>
+            void array(vector<T>& values) {
+                size_t n = 0;
+                auto src = array<T>(n);
+                values.resize(n);
+                if (n > 0) memcpy(values.data(), src, sizeof(T)*n);
+            }
+        };
+    }
+} // namespace NRenderer
+
+#endif
\ No newline at end of file
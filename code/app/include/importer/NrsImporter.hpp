@@ -0,0 +1,27 @@
+#pragma once
+#ifndef __NR_NRS_IMPORTER_HPP__
+#define __NR_NRS_IMPORTER_HPP__
+
+// Ƴļͷļ
+// NrsExporterд.nrsļ
+
+#include "Importer.hpp"
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // NRSļ
+    // ļڴӳ䷽ʽ򿪣ֶε鸴ƵʲУ
+    class NrsImporter: public Importer
+    {
+    public:
+        // NRSļ
+        // asset: Ŀʲ
+        // path: NRSļ·
+        // : Ƿɹ
+        virtual bool import(Asset& asset, const string& path) override;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 // ˵OBJʽ3DģļĹ
 
 #include "Importer.hpp"
+#include "utilities/AsyncTextureLoader.hpp"
 #include <map>
 
 #include <unordered_map>
@@ -19,13 +20,25 @@ namespace NRenderer
     class ObjImporter: public Importer
     {
     private:
+        // õɺٰ󶨵
+        struct TextureRequest
+        {
+            size_t material;                    // ±
+            string key;                         // 
+            string name;                        // 
+            shared_future<SharedTexture> texture;
+        };
+
         // MTLļ
         // asset: Ŀʲ
         // path: MTLļ·
         // file: MTLļ
         // mtlMap: Ƶӳ
+        // textureLoader: ͼ乤߳н
+        // textureRequests: 
         // : Ƿɹ
-        bool parseMtl(Asset& asset, const string& path, ifstream& file, unordered_map<string, size_t>& mtlMap);
+        bool parseMtl(Asset& asset, const string& path, ifstream& file, unordered_map<string, size_t>& mtlMap,
+            AsyncTextureLoader& textureLoader, vector<TextureRequest>& textureRequests);
     public:
         // OBJļ
         // asset: Ŀʲ
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef __NR_PLY_IMPORTER_HPP__
+#define __NR_PLY_IMPORTER_HPP__
+
+// PLYļͷļ
+// СPLYļҪڴģɨģ
+
+#include "Importer.hpp"
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // PLYļ
+    // ļڴӳ䷽ʽ򿪣ԪذԲֱӸƵУ
+    // 水ǻļûзʱм㶥㷨
+    class PlyImporter: public Importer
+    {
+    public:
+        // PLYļ
+        // asset: Ŀʲ
+        // path: PLYļ·
+        // : Ƿɹ
+        virtual bool import(Asset& asset, const string& path) override;
+    };
+}
+
+#endif
\ No newline at end of file
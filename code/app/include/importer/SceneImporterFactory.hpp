@@ -11,6 +11,9 @@
 #include "Importer.hpp"
 #include "ScnImporter.hpp"
 #include "ObjImporter.hpp"
+#include "NrsImporter.hpp"
+#include "GlbImporter.hpp"
+#include "PlyImporter.hpp"
 
 namespace NRenderer
 {
@@ -35,6 +38,10 @@ namespace NRenderer
         SceneImporterFactory() {
             importerMap["scn"] = make_shared<ScnImporter>();  // SCNʽ
             importerMap["obj"] = make_shared<ObjImporter>();  // OBJʽ
+            importerMap["nrs"] = make_shared<NrsImporter>();  // ӶƳʽ
+            importerMap["glb"] = make_shared<GlbImporter>();  // glTFƸʽ
+            importerMap["gltf"] = make_shared<GlbImporter>(); // glTFıʽ
+            importerMap["ply"] = make_shared<PlyImporter>();  // PLYʽ
         }
 
         // ȡָļʽĵ
@@ -9,6 +9,7 @@
 #include "importer/TextureImporter.hpp"
 #include "utilities/FileFetcher.hpp"
 #include "importer/SceneImporterFactory.hpp"
+#include "exporter/NrsExporter.hpp"
 #include "utilities/File.hpp"
 #include "server/Server.hpp"
 
@@ -21,13 +22,15 @@ namespace NRenderer
         Asset asset;  // ʲʵ
 
         // 볡ļ
-        // ֵ֧ .scn  .obj ʽĳļ
+        // ֵ֧ .scn.obj.nrs.ply  glTF.glb.gltfʽĳļ
         void importScene() {
             FileFetcher ff;
-            auto optPath = ff.fetch("All\0*.scn;*.obj\0");
+            auto optPath = ff.fetch("All\0*.scn;*.obj;*.nrs;*.ply;*.glb;*.gltf\0");
             if (optPath) {
                 auto importer = SceneImporterFactory::instance().importer(File::getFileExtension(*optPath));
                 bool success = importer->import(asset, *optPath);
+                // ʧʱҲд벿ʲ
+                asset.markAllDirty();
                 if (!success) {
                     getServer().logger.error(importer->getErrorInfo());
                 }
@@ -37,6 +40,22 @@ namespace NRenderer
             }
         }
 
+        // ļ
+        // ѵǰȫʲд .nrs ʽֱ֮ӵ½
+        void exportScene() {
+            FileFetcher ff;
+            auto optPath = ff.fetchSave("NRS\0*.nrs\0", "nrs");
+            if (optPath) {
+                NrsExporter exporter;
+                if (!exporter.exportAsset(asset, *optPath)) {
+                    getServer().logger.error(exporter.getErrorInfo());
+                }
+                else {
+                    getServer().logger.success("ɹ:" + *optPath);
+                }
+            }
+        }
+
         // ļ
         // ֵ֧ .png  .jpg ʽͼƬļ
         void importTexture() {
@@ -45,6 +64,7 @@ namespace NRenderer
             auto optPath = ff.fetch("image\0*.png;*.jpg\0");
             if (optPath) {
                 tImp.import(asset, *optPath);
+                asset.markTextureDirty();
             }
         }
 
@@ -34,6 +34,7 @@ namespace NRenderer
         State state;                    // ǰ״̬
         vector<HMODULE> loadedDlls;     // ѼصDLLģб
         ComponentInfo activeComponent;   // ǰϢ
+        SharedInstance activeInstance;   // ǰʵ
         chrono::system_clock::time_point lastStartTime;  // ϴοʼʱ
         chrono::system_clock::time_point lastEndTime;    // ϴνʱ
         thread t;                       // ִ߳
@@ -60,6 +61,7 @@ namespace NRenderer
         void exec(const ComponentInfo& componentInfo, Args... args) {
             auto component = getServer().componentFactory.createComponent<Interface>(componentInfo.type, componentInfo.name);
             activeComponent = componentInfo;
+            activeInstance = component;
             this->state = State::READY;
             try {
                 t = thread(&Interface::exec,
@@ -84,6 +86,9 @@ namespace NRenderer
         // ִ
         void finish();
 
+        // ǰеȾǰ
+        void requestStop();
+
         // ȡǰ״̬
         // : ǰ״̬
         State getState() const;
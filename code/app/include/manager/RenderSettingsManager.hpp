@@ -8,15 +8,35 @@ namespace NRenderer
 {
     struct RenderSettings
     {
+        enum class SamplerType
+        {
+            RANDOM, HALTON, SOBOL
+        };
         unsigned int width;
         unsigned int height;
         unsigned int depth;
         unsigned int samplesPerPixel;
+        bool progressive;
+        unsigned int samplesPerPass;
+        bool adaptiveSampling;
+        float adaptiveThreshold;
+        unsigned int threads;
+        SamplerType sampler;
+        unsigned int seed;
+        bool denoise;
         RenderSettings()
             : width             (500)
             , height            (500)
             , depth             (4)
             , samplesPerPixel   (16)
+            , progressive       (false)
+            , samplesPerPass    (1)
+            , adaptiveSampling  (false)
+            , adaptiveThreshold (0.02f)
+            , threads           (0)
+            , sampler           (SamplerType::SOBOL)
+            , seed              (0)
+            , denoise           (false)
         {}
     };
     struct AmbientSettings
@@ -26,7 +26,8 @@ namespace NRenderer
             PREVIEW_NONE,              // Ԥ
             PREVIEW_MODEL,             // Ԥģ
             PREVIEW_NODE,              // Ԥڵ
-            PREVIEW_LIGHT              // ԤԴ
+            PREVIEW_LIGHT,             // ԤԴ
+            PREVIEW_INSTANCE           // Ԥģʵ
         };
 
         PreviewMode previewMode;       // ǰԤģʽ
@@ -34,6 +35,7 @@ namespace NRenderer
         Index previewModel;            // Ԥģ
         Index previewNode;             // ԤĽڵ
         Index previewLight;            // ԤĹԴ
+        Index previewInstance;         // Ԥģʵ
 
         // 캯
         // ʼUIΪĬ״̬
@@ -42,6 +44,7 @@ namespace NRenderer
             , previewNode(-1)                          // Ԥڵ
             , previewLight(-1)                         // ԤԴ
             , previewModel(-1)                         // Ԥģ
+            , previewInstance(-1)                      // Ԥʵ
             , previewMode(PreviewMode::PREVIEW_NONE)   // Ԥģʽ
         {}
 
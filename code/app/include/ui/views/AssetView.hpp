@@ -38,7 +38,8 @@ namespace NRenderer
 
         // Ա༭
         // spMaterial: Ҫ༭Ĳָ
-        void materialPropEditor(SharedMaterial spMaterial);
+        // ֵ: Ƿ޸
+        bool materialPropEditor(SharedMaterial spMaterial);
 
     public:
         // 캯
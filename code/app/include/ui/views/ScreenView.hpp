@@ -8,6 +8,7 @@
 #include "View.hpp"
 #include "utilities/GlImage.hpp"
 #include "utilities/GlShader.hpp"
+#include "server/Framebuffer.hpp"
 
 namespace NRenderer
 {
@@ -50,6 +51,8 @@ namespace NRenderer
 
         void genFB();                             // ֡
         void previewNode(const NodeItem& n);      // Ԥڵ
+        // 任Ԥڵ㣨ģʵscaleΪ任е
+        void previewNode(const NodeItem& n, const Mat4x4& transform, const Vec3& scale);
         void previewLight(const LightItem& l);    // ԤԴ
 
         void align(const Vec2& size);             // ͼС
@@ -65,7 +68,11 @@ namespace NRenderer
 
         int shrinkLevel;                          // ż
 
+        Framebuffer::Channel resultChannel;       // ģʽʾͨ
+        bool resultChannelChanged;                // ʾͨǷı
+
         GlImageId renderResult;                   // Ⱦ
+        Vec2 resultSize;                          // Ⱦĳߴ
         GlImageId previewResult;                  // Ԥ
     public:
         // 캯
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef __NR_ASYNC_TEXTURE_LOADER_HPP__
+#define __NR_ASYNC_TEXTURE_LOADER_HPP__
+
+// 첽ͷļ
+// ڹ߳нͼɶ༶Զͬһļֻһ
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <future>
+#include <condition_variable>
+#include <unordered_map>
+
+#include "scene/Texture.hpp"
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // 첽
+    // futureڹ߳нУʧʱfutureֵΪnullptr
+    // OpenGLҪڳĵ߳д˲ϴ
+    class AsyncTextureLoader
+    {
+    private:
+        struct Task
+        {
+            string path;
+            const char* data = nullptr;     // ڴеıͼΪnullptrʱpathȡ
+            size_t size = 0;
+            promise<SharedTexture> result;
+        };
+
+        vector<thread> workers;
+        deque<Task> tasks;
+        mutex lock;
+        condition_variable cv;
+        bool stopping;
+        unsigned int maxWorkers;
+        // 淶·ؽӳ
+        unordered_map<string, shared_future<SharedTexture>> cache;
+
+        void work();
+
+        // ȥغ
+        shared_future<SharedTexture> enqueue(const string& key, Task task);
+
+    public:
+        // threads: ߳0ʾʹӲ߳ڵһʱ贴
+        explicit AsyncTextureLoader(unsigned int threads = 0);
+        // ȴڽɣδʼ󱻶
+        ~AsyncTextureLoader();
+
+        AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+        AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+        // 
+        // path: ͼļ·淶ͬ·ͬһ
+        shared_future<SharedTexture> request(const string& path);
+
+        // ڴеıͼglTFǶPNGJPEG
+        // key: ȥõļͬļͬһ
+        // data: ͼݣڽ֮ǰ뱣Ч
+        // size: ֽ
+        shared_future<SharedTexture> request(const string& key, const char* data, size_t size);
+    };
+} // namespace NRenderer
+
+#endif
\ No newline at end of file
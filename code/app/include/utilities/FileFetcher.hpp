@@ -26,6 +26,12 @@ namespace NRenderer
         // filter: ļַ "*.obj"
         // ûѡļ·ûȡ򷵻ؿ
         optional<string> fetch(const char* filter) const;
+
+        // ȡļ·
+        // filter: ļַ
+        // defaultExt: ûδչʱ׷ӵչ㣩
+        // ûļ·ûȡ򷵻ؿ
+        optional<string> fetchSave(const char* filter, const char* defaultExt) const;
     };
 } // namespace NRenderer
 
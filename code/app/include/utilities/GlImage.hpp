@@ -6,6 +6,7 @@
 // ṩOpenGLļغ͹
 
 #include "geometry/vec.hpp"
+#include "scene/Texture.hpp"
 #include "glad/glad.h"
 
 namespace NRenderer
@@ -36,6 +37,30 @@ namespace NRenderer
             return id;
         }
 
+        // Ĵ洢ʽֱϴ0չΪȸ
+        // texture: 
+        // ɵID
+        static GlImageId loadTexture(const Texture& texture) {
+            if (texture.format == Texture::Format::RGBA32F) {
+                return loadImage(texture.rgba, {texture.width, texture.height});
+            }
+            GlImageId id  = 0u;
+            glGenTextures(1, &id);
+            glBindTexture(GL_TEXTURE_2D, id);
+            // ˲
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            // ϴ
+            if (texture.format == Texture::Format::RGBA8) {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, texture.width, texture.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.packed->data());
+            }
+            else {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, texture.width, texture.height, 0, GL_RGBA, GL_HALF_FLOAT, texture.packed->data());
+            }
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return id;
+        }
+
         // ɾOpenGL
         // id: ҪɾID
         static void deleteImage(GlImageId id) {
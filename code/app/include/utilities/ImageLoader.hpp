@@ -8,6 +8,7 @@
 #include <string>
 
 #include "geometry/vec.hpp"
+#include "scene/Texture.hpp"
 #include "Image.hpp"
 
 namespace NRenderer {
@@ -28,6 +29,20 @@ namespace NRenderer {
         // channel: ͼͨĬΪ4RGBA
         // ؼصͼݣʧܷnullptr
 		Image* load(const string& file, int channel = 4);
+
+        // ͼļΪոʽ
+        // 8λͼRGBA8棬HDRͼ񰴰뾫ȸRGBA16F棬ȸмͼ
+        // file: ͼļ·
+        // texture: 
+        // Ƿسɹ
+		bool loadTexture(const string& file, Texture& texture);
+
+        // ڴеıͼPNGJPEGʽͬ
+        // data: ͼ
+        // size: ֽ
+        // texture: 
+        // Ƿسɹ
+		bool loadTexture(const unsigned char* data, size_t size, Texture& texture);
 	};
 }
 
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef __NR_JSON_HPP__
+#define __NR_JSON_HPP__
+
+// JSONͷļ
+// ֻļJSONĵڽglTFȳļ
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <optional>
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // JSONֵ
+    // ʲڵĳԱ±ʱؿֵ𼶼
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT
+        };
+
+    private:
+        Type type;
+        bool boolean;
+        double number;
+        string str;
+        vector<JsonValue> elements;                 // Ԫ
+        vector<pair<string, JsonValue>> members;    // Աļе˳
+
+        friend class JsonParser;
+
+        // ȱʧֵĿֵ
+        static const JsonValue& null();
+
+    public:
+        JsonValue()
+            : type      (Type::NUL)
+            , boolean   (false)
+            , number    (0)
+        {}
+
+        Type getType() const { return type; }
+        bool isNull() const { return type == Type::NUL; }
+        bool isNumber() const { return type == Type::NUMBER; }
+        bool isString() const { return type == Type::STRING; }
+        bool isArray() const { return type == Type::ARRAY; }
+        bool isObject() const { return type == Type::OBJECT; }
+
+        // ԪĳԱ
+        size_t size() const {
+            return type == Type::ARRAY ? elements.size() : (type == Type::OBJECT ? members.size() : 0);
+        }
+
+        // Աʱؿֵ
+        const JsonValue& operator[](const string& key) const;
+        // ԪأԽʱؿֵ
+        const JsonValue& operator[](size_t index) const;
+        // ǷĳԱ
+        bool has(const string& key) const;
+
+        const vector<JsonValue>& array() const { return elements; }
+        const vector<pair<string, JsonValue>>& object() const { return members; }
+
+        // ȡֵͲʱĬֵ
+        double asNumber(double defaultValue = 0) const { return type == Type::NUMBER ? number : defaultValue; }
+        bool asBool(bool defaultValue = false) const { return type == Type::BOOLEAN ? boolean : defaultValue; }
+        const string& asString() const { return str; }
+
+        // JSONı
+        // text: JSONı
+        // error: ʧʱĴϢ
+        // : õֵʧʱΪ
+        static optional<JsonValue> parse(string_view text, string& error);
+    };
+} // namespace NRenderer
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef __NR_MAPPED_FILE_HPP__
+#define __NR_MAPPED_FILE_HPP__
+
+// ڴӳļͷļ
+// ֻʽļӳ䵽ڴ棬ļжȡ븴
+
+#include <string>
+#include <cstddef>
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // ֻڴӳļ
+    // ӳڶʱɸƣƶ
+    class MappedFile
+    {
+    private:
+        const char* ptr;        // ӳ׵ַļʧʱΪnullptr
+        size_t length;          // ļֽ
+#ifdef _WIN32
+        void* fileHandle;       // ļ
+        void* mappingHandle;    // ӳ
+#else
+        int fd;                 // ļ
+#endif
+        bool opened;            // Ƿɹ
+
+        void close();
+
+    public:
+        // 򿪲ӳļ
+        // path: ļ·
+        explicit MappedFile(const string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+
+        // Ƿɹ򿪣ļҲɹ
+        bool isOpen() const { return opened; }
+
+        // ļ
+        const char* data() const { return ptr; }
+
+        // ļֽ
+        size_t size() const { return length; }
+    };
+} // namespace NRenderer
+
+#endif
\ No newline at end of file
@@ -13,13 +13,43 @@ namespace NRenderer
         ro.samplesPerPixel = renderSettings.samplesPerPixel;  // ÿز
         ro.width = renderSettings.width;                    // Ⱦ
         ro.height = renderSettings.height;                  // Ⱦ߶
+        ro.progressive = renderSettings.progressive;        // ʽȾ
+        ro.samplesPerPass = renderSettings.samplesPerPass;  // ʽȾÿֲ
+        ro.adaptiveSampling = renderSettings.adaptiveSampling;    // Ӧ
+        ro.adaptiveThreshold = renderSettings.adaptiveThreshold;  // Ӧֵ
+        ro.threads = renderSettings.threads;                // Ⱦ߳
+        ro.seed = renderSettings.seed;                      // 
+        ro.denoise = renderSettings.denoise;                // 
+        // 
+        if (renderSettings.sampler == RenderSettings::SamplerType::RANDOM) {
+            ro.sampler = RenderOption::SamplerType::RANDOM;
+        }
+        else if (renderSettings.sampler == RenderSettings::SamplerType::HALTON) {
+            ro.sampler = RenderOption::SamplerType::HALTON;
+        }
+        else {
+            ro.sampler = RenderOption::SamplerType::SOBOL;
+        }
         this->scene->renderOption = ro;
     }
 
     // 
-    // ʲݸƵ
+    // Сʵ尴ֵƵУȾԾ͵޸ģ綥任
+    // 񶥵ȴֻãʲ
     void SceneBuilder::buildBuffer() {
-        // Ʋʡģ
+        auto& s = *this->scene;
+        s.materials.reserve(asset.materialItems.size());
+        s.textures.reserve(asset.textureItems.size());
+        s.models.reserve(asset.modelItems.size());
+        s.nodes.reserve(asset.nodeItems.size());
+        s.instances.reserve(asset.instanceItems.size());
+        s.lights.reserve(asset.lightItems.size());
+        s.sphereBuffer.reserve(asset.spheres.size());
+        s.triangleBuffer.reserve(asset.triangles.size());
+        s.planeBuffer.reserve(asset.planes.size());
+        s.meshBuffer.reserve(asset.meshes.size());
+
+        // Ʋʡģݣֻؿã
         for (auto& mi : asset.materialItems) {
             this->scene->materials.push_back(*mi.material);
         }
@@ -63,6 +93,15 @@ namespace NRenderer
             }
         }
 
+        // ģʵֻб任ģ͵Ľڵ
+        for (auto& ii : asset.instanceItems) {
+            if (ii.instance->model >= asset.modelItems.size()) {
+                success = false;
+                continue;
+            }
+            this->scene->instances.push_back(*ii.instance);
+        }
+
         // ƹԴ
         for (auto& li : asset.lightItems) {
             this->scene->lights.push_back(*li.light);
@@ -79,7 +118,7 @@ namespace NRenderer
             this->scene->planeBuffer.push_back(*p);
         }
         for (auto& m : asset.meshes) {
-            this->scene->meshBuffer.push_back(*m);
+            this->scene->meshBuffer.push_back(m);
         }
 
         // ƸԴ
@@ -116,6 +155,16 @@ namespace NRenderer
         }
     }
 
+    // ʲİ汾
+    // Ⱦݴ˸ϴȾ
+    void SceneBuilder::buildVersion() {
+        auto& v = this->scene->version;
+        v.geometry = asset.geometryVersion;
+        v.material = asset.materialVersion;
+        v.texture = asset.textureVersion;
+        v.light = asset.lightVersion;
+    }
+
     // 
     // عõĳ
     SharedScene SceneBuilder::build() {
@@ -124,6 +173,7 @@ namespace NRenderer
         this->buildCamera();                 // 
         this->buildBuffer();                 // 
         this->buildAmbient();               // 
+        this->buildVersion();               // ʲ汾
         if (success)
             return this->scene;              // ɹس
         else 
@@ -0,0 +1,239 @@
+// Ƴļʵļ
+// ֶηֱдڴ滺ͬļͷֶαһд
+
+#include "exporter/NrsExporter.hpp"
+#include "importer/NrsFormat.hpp"
+
+#include <fstream>
+
+namespace NRenderer
+{
+    using namespace Nrs;
+
+    namespace
+    {
+        // дķֶ
+        struct PendingSection
+        {
+            Section type;
+            uint32_t count;
+            Writer writer;
+        };
+
+        void writeMaterials(const Asset& asset, Writer& w) {
+            using PT = Property::Type;
+            using PW = Property::Wrapper;
+            for (auto& item : asset.materialItems) {
+                w.str(item.name);
+                Material empty{};
+                auto& material = item.material ? *item.material : empty;
+                w.pod(uint32_t(material.type));
+                w.pod(uint32_t(material.properties.size()));
+                for (auto& prop : material.properties) {
+                    w.str(prop.key);
+                    w.pod(uint32_t(prop.type));
+                    switch (prop.type) {
+                        case PT::INT:           w.pod(int32_t(get<PW::IntType>(prop.valueWrapper).value)); break;
+                        case PT::FLOAT:         w.pod(get<PW::FloatType>(prop.valueWrapper).value); break;
+                        case PT::RGB:           w.pod(get<PW::RGBType>(prop.valueWrapper).value); break;
+                        case PT::RGBA:          w.pod(get<PW::RGBAType>(prop.valueWrapper).value); break;
+                        case PT::VEC3:          w.pod(get<PW::Vec3Type>(prop.valueWrapper).value); break;
+                        case PT::VEC4:          w.pod(get<PW::Vec4Type>(prop.valueWrapper).value); break;
+                        case PT::TEXTURE_ID:    w.pod(uint64_t(get<PW::TextureIdType>(prop.valueWrapper).value.getValue())); break;
+                    }
+                }
+            }
+        }
+
+        // 洢ʽԭдͬɵĶ༶Զȡʱ
+        void writeTextures(const Asset& asset, Writer& w) {
+            for (auto& item : asset.textureItems) {
+                w.str(item.name);
+                Texture empty{};
+                auto& texture = (item.texture && !item.texture->empty()) ? *item.texture : empty;
+                w.pod(uint32_t(texture.format));
+                w.pod(uint32_t(texture.width));
+                w.pod(uint32_t(texture.height));
+                if (texture.empty()) {
+                    w.array<unsigned char>(nullptr, 0);
+                }
+                else if (texture.format == Texture::Format::RGBA32F) {
+                    w.array(reinterpret_cast<const unsigned char*>(texture.rgba), size_t(texture.width)*texture.height*sizeof(RGBA));
+                }
+                else {
+                    w.array(*texture.packed);
+                }
+                w.pod(uint32_t(texture.mipmaps ? texture.mipmaps->size() : 0));
+                if (texture.mipmaps) {
+                    for (auto& level : *texture.mipmaps) {
+                        w.pod(uint32_t(level.width));
+                        w.pod(uint32_t(level.height));
+                        w.array(level.data);
+                    }
+                }
+            }
+        }
+
+        void writeModels(const Asset& asset, Writer& w) {
+            for (auto& item : asset.modelItems) {
+                w.str(item.name);
+                Model empty{};
+                auto& model = item.model ? *item.model : empty;
+                w.pod(model.translation);
+                w.pod(model.scale);
+                w.pod(uint32_t(model.visible ? 1 : 0));
+                w.array(model.nodes);
+            }
+        }
+
+        void writeNodes(const Asset& asset, Writer& w) {
+            for (auto& item : asset.nodeItems) {
+                w.str(item.name);
+                Node empty{};
+                auto& node = item.node ? *item.node : empty;
+                w.pod(uint32_t(node.type));
+                w.pod(uint32_t(node.entity));
+                w.pod(uint32_t(node.model));
+            }
+        }
+
+        void writeInstances(const Asset& asset, Writer& w) {
+            for (auto& item : asset.instanceItems) {
+                w.str(item.name);
+                ModelInstance empty{};
+                auto& instance = item.instance ? *item.instance : empty;
+                w.pod(uint32_t(instance.model));
+                w.pod(instance.translation);
+                w.pod(instance.rotation);
+                w.pod(instance.scale);
+            }
+        }
+
+        void writeSpheres(const Asset& asset, Writer& w) {
+            for (auto& sp : asset.spheres) {
+                Sphere s = sp ? *sp : Sphere{};
+                w.pod(uint64_t(s.material.getValue()));
+                w.pod(s.direction);
+                w.pod(s.position);
+                w.pod(s.radius);
+            }
+        }
+
+        void writeTriangles(const Asset& asset, Writer& w) {
+            for (auto& sp : asset.triangles) {
+                Triangle t = sp ? *sp : Triangle{};
+                w.pod(uint64_t(t.material.getValue()));
+                for (int i = 0; i < 3; i++) {
+                    w.pod(t.v[i]);
+                }
+                w.pod(t.normal);
+            }
+        }
+
+        void writePlanes(const Asset& asset, Writer& w) {
+            for (auto& sp : asset.planes) {
+                Plane p = sp ? *sp : Plane{};
+                w.pod(uint64_t(p.material.getValue()));
+                w.pod(p.normal);
+                w.pod(p.position);
+                w.pod(p.u);
+                w.pod(p.v);
+            }
+        }
+
+        // Ķ鰴16ֽڶд
+        void writeMeshes(const Asset& asset, Writer& w) {
+            for (auto& sp : asset.meshes) {
+                Mesh empty{};
+                auto& mesh = sp ? *sp : empty;
+                w.pod(uint64_t(mesh.material.getValue()));
+                w.array(mesh.normals);
+                w.array(mesh.positions);
+                w.array(mesh.uvs);
+                w.array(mesh.normalIndices);
+                w.array(mesh.positionIndices);
+                w.array(mesh.uvIndices);
+            }
+        }
+
+        void writeLights(const Asset& asset, Writer& w) {
+            for (auto& item : asset.lightItems) {
+                w.str(item.name);
+                Light empty{Light::Type::POINT};
+                auto& light = item.light ? *item.light : empty;
+                w.pod(uint32_t(light.type));
+                w.pod(uint32_t(light.entity));
+            }
+        }
+
+        // Դݾɸɣûֽڣṹд
+        template<typename T>
+        void writeLightBuffer(const vector<shared_ptr<T>>& lights, Writer& w) {
+            static_assert(is_trivially_copyable_v<T>, "light data must be trivially copyable");
+            for (auto& sp : lights) {
+                w.pod(sp ? *sp : T{});
+            }
+        }
+    }
+
+    bool NrsExporter::exportAsset(const Asset& asset, const string& path) {
+        vector<PendingSection> sections;
+        auto add = [&sections](Section type, size_t count, auto&& write) {
+            if (count == 0) return;
+            sections.push_back({type, uint32_t(count), {}});
+            write(sections.back().writer);
+        };
+        add(Section::MATERIALS,             asset.materialItems.size(),     [&](Writer& w) { writeMaterials(asset, w); });
+        add(Section::TEXTURES,              asset.textureItems.size(),      [&](Writer& w) { writeTextures(asset, w); });
+        add(Section::MODELS,                asset.modelItems.size(),        [&](Writer& w) { writeModels(asset, w); });
+        add(Section::NODES,                 asset.nodeItems.size(),         [&](Writer& w) { writeNodes(asset, w); });
+        add(Section::INSTANCES,             asset.instanceItems.size(),     [&](Writer& w) { writeInstances(asset, w); });
+        add(Section::SPHERES,               asset.spheres.size(),           [&](Writer& w) { writeSpheres(asset, w); });
+        add(Section::TRIANGLES,             asset.triangles.size(),         [&](Writer& w) { writeTriangles(asset, w); });
+        add(Section::PLANES,                asset.planes.size(),            [&](Writer& w) { writePlanes(asset, w); });
+        add(Section::MESHES,                asset.meshes.size(),            [&](Writer& w) { writeMeshes(asset, w); });
+        add(Section::LIGHTS,                asset.lightItems.size(),        [&](Writer& w) { writeLights(asset, w); });
+        add(Section::POINT_LIGHTS,          asset.pointLights.size(),       [&](Writer& w) { writeLightBuffer(asset.pointLights, w); });
+        add(Section::AREA_LIGHTS,           asset.areaLights.size(),        [&](Writer& w) { writeLightBuffer(asset.areaLights, w); });
+        add(Section::DIRECTIONAL_LIGHTS,    asset.directionalLights.size(), [&](Writer& w) { writeLightBuffer(asset.directionalLights, w); });
+        add(Section::SPOT_LIGHTS,           asset.spotLights.size(),        [&](Writer& w) { writeLightBuffer(asset.spotLights, w); });
+
+        // ֶεƫƣֶ㰴64ֽڶ
+        auto alignUp = [](uint64_t v) { return (v + sectionAlignment - 1) / sectionAlignment * sectionAlignment; };
+        vector<SectionEntry> table;
+        uint64_t offset = alignUp(sizeof(Header) + sizeof(SectionEntry)*sections.size());
+        for (auto& s : sections) {
+            uint64_t size = s.writer.data().size();
+            table.push_back({uint32_t(s.type), s.count, offset, size});
+            offset = alignUp(offset + size);
+        }
+
+        Header header{};
+        memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.sectionCount = uint32_t(sections.size());
+        header.fileSize = offset;
+
+        ofstream file(path, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            lastErrorInfo = "Failed to open file for writing: " + path;
+            return false;
+        }
+        const char zeros[sectionAlignment] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(table.data()), sizeof(SectionEntry)*table.size());
+        uint64_t written = sizeof(Header) + sizeof(SectionEntry)*table.size();
+        for (size_t i = 0; i < sections.size(); i++) {
+            file.write(zeros, table[i].offset - written);
+            auto& data = sections[i].writer.data();
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            written = table[i].offset + data.size();
+        }
+        file.write(zeros, offset - written);
+        if (!file.good()) {
+            lastErrorInfo = "Failed to write file: " + path;
+            return false;
+        }
+        return true;
+    }
+}
\ No newline at end of file
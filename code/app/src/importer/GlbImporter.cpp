@@ -0,0 +1,747 @@
+// glTF 2.0ļʵļ
+// .glbJSONƿ飬Ѷ鸴ƵС
+// 뵽ǿʲʱļе±궼϶Ӧʲбԭеĳ
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <list>
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "utilities/File.hpp"
+#include "utilities/AsyncTextureLoader.hpp"
+#include "utilities/GlImage.hpp"
+#include "utilities/Json.hpp"
+#include "utilities/MappedFile.hpp"
+
+#include "importer/GlbImporter.hpp"
+
+namespace NRenderer
+{
+    namespace
+    {
+        constexpr uint32_t glbMagic = 0x46546C67;       // "glTF"
+        constexpr uint32_t glbVersion = 2;
+        constexpr uint32_t chunkJson = 0x4E4F534A;      // "JSON"
+        constexpr uint32_t chunkBin = 0x004E4942;       // "BIN\0"
+
+        // ķ
+        enum ComponentType : uint32_t
+        {
+            BYTE = 5120,
+            UNSIGNED_BYTE = 5121,
+            SHORT = 5122,
+            UNSIGNED_SHORT = 5123,
+            UNSIGNED_INT = 5125,
+            FLOAT = 5126
+        };
+
+        // ͼԪĻƷʽֻ
+        enum PrimitiveMode : uint32_t
+        {
+            TRIANGLES = 4,
+            TRIANGLE_STRIP = 5,
+            TRIANGLE_FAN = 6
+        };
+
+        static_assert(sizeof(Index) == 4, "Index must match UNSIGNED_INT indices.");
+        static_assert(sizeof(Vec3) == 12 && sizeof(Vec2) == 8, "Vectors must be tightly packed floats.");
+
+        size_t componentSize(uint32_t type) {
+            switch (type) {
+                case BYTE: case UNSIGNED_BYTE: return 1;
+                case SHORT: case UNSIGNED_SHORT: return 2;
+                case UNSIGNED_INT: case FLOAT: return 4;
+                default: return 0;
+            }
+        }
+
+        size_t componentCount(const string& type) {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            if (type == "MAT2") return 4;
+            if (type == "MAT3") return 9;
+            if (type == "MAT4") return 16;
+            return 0;
+        }
+
+        // ȡһ޷
+        uint32_t readUint(const char* p, uint32_t type) {
+            if (type == UNSIGNED_BYTE) return uint8_t(*p);
+            if (type == UNSIGNED_SHORT) {
+                uint16_t v;
+                memcpy(&v, p, 2);
+                return v;
+            }
+            uint32_t v;
+            memcpy(&v, p, 4);
+            return v;
+        }
+
+        // ȡ±꣬[0, count)ڵʱfalse
+        bool indexOf(const JsonValue& v, size_t count, size_t& out) {
+            double d = v.asNumber(-1);
+            if (d < 0 || d >= double(count) || d != floor(d)) return false;
+            out = size_t(d);
+            return true;
+        }
+
+        // ȡǸȱʡʱȡdefaultValue
+        bool sizeOf(const JsonValue& v, size_t defaultValue, size_t& out) {
+            if (v.isNull()) {
+                out = defaultValue;
+                return true;
+            }
+            double d = v.asNumber(-1);
+            if (d < 0 || d > 9.0e15 || d != floor(d)) return false;
+            out = size_t(d);
+            return true;
+        }
+
+        // ȡ飬ȲʱĬֵ
+        template<typename V>
+        V floats(const JsonValue& v, V value) {
+            for (size_t i = 0; i < v.size() && i < sizeof(V)/sizeof(float); i++) {
+                value[typename V::length_type(i)] = float(v[i].asNumber(value[typename V::length_type(i)]));
+            }
+            return value;
+        }
+
+        // base64data URIǶĻͼ
+        bool decodeBase64(string_view text, string& out) {
+            auto value = [](char c) -> int {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+') return 62;
+                if (c == '/') return 63;
+                return -1;
+            };
+            out.clear();
+            out.reserve(text.size()/4*3);
+            uint32_t bits = 0;
+            int bitCount = 0;
+            for (char c : text) {
+                if (c == '=') break;
+                int v = value(c);
+                if (v < 0) return false;
+                bits = (bits << 6) | uint32_t(v);
+                bitCount += 6;
+                if (bitCount >= 8) {
+                    bitCount -= 8;
+                    out += char((bits >> bitCount) & 0xff);
+                }
+            }
+            return true;
+        }
+
+        // ķһԪصĵַԪصļ࣬Ѽ鲻Խͼ
+        struct Accessor
+        {
+            const char* data = nullptr;
+            size_t count = 0;
+            size_t stride = 0;
+            uint32_t componentType = 0;
+            size_t components = 0;
+            bool normalized = false;
+
+            // ԪǷĿ겼һ£ʱ鸴
+            bool tight(uint32_t type, size_t n) const {
+                return componentType == type && components == n && stride == componentSize(type)*n;
+            }
+        };
+
+        // ȡԣʱ鸴ƣ򰴼ƣ
+        // 껹һ޷
+        template<typename V>
+        bool readFloats(const Accessor& a, vector<V>& out) {
+            constexpr size_t n = sizeof(V)/sizeof(float);
+            if (a.components != n) return false;
+            out.resize(a.count);
+            if (a.tight(FLOAT, n)) {
+                if (a.count != 0) memcpy(out.data(), a.data, a.count*sizeof(V));
+                return true;
+            }
+            if (a.componentType == FLOAT) {
+                for (size_t i = 0; i < a.count; i++) {
+                    memcpy(&out[i], a.data + i*a.stride, sizeof(V));
+                }
+                return true;
+            }
+            if (a.normalized && (a.componentType == UNSIGNED_BYTE || a.componentType == UNSIGNED_SHORT)) {
+                float scale = a.componentType == UNSIGNED_BYTE ? 1.f/255.f : 1.f/65535.f;
+                size_t size = componentSize(a.componentType);
+                for (size_t i = 0; i < a.count; i++) {
+                    for (size_t k = 0; k < n; k++) {
+                        out[i][typename V::length_type(k)] = float(readUint(a.data + i*a.stride + k*size, a.componentType))*scale;
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+
+        // ȡ32λҽʱ鸴ƣ8λ16λչ
+        bool readIndices(const Accessor& a, vector<Index>& out) {
+            if (a.components != 1 || a.normalized) return false;
+            if (a.componentType != UNSIGNED_BYTE && a.componentType != UNSIGNED_SHORT && a.componentType != UNSIGNED_INT) return false;
+            out.resize(a.count);
+            if (a.tight(UNSIGNED_INT, 1)) {
+                if (a.count != 0) memcpy(out.data(), a.data, a.count*sizeof(Index));
+                return true;
+            }
+            for (size_t i = 0; i < a.count; i++) {
+                out[i] = readUint(a.data + i*a.stride, a.componentType);
+            }
+            return true;
+        }
+
+        // δչΪб˳glTF淶һ
+        void toTriangleList(uint32_t mode, vector<Index>& indices) {
+            if (mode == TRIANGLES) {
+                indices.resize(indices.size()/3*3);
+                return;
+            }
+            vector<Index> triangles;
+            if (indices.size() >= 3) triangles.reserve((indices.size() - 2)*3);
+            for (size_t i = 0; i + 2 < indices.size(); i++) {
+                if (mode == TRIANGLE_STRIP) {
+                    triangles.push_back(indices[i]);
+                    triangles.push_back(indices[i + 1 + i%2]);
+                    triangles.push_back(indices[i + 2 - i%2]);
+                }
+                else {
+                    triangles.push_back(indices[i + 1]);
+                    triangles.push_back(indices[i + 2]);
+                    triangles.push_back(indices[0]);
+                }
+            }
+            indices.swap(triangles);
+        }
+
+        // ѽڵ任ֽΪʵƽơתXYZĽǶȣţб䱻
+        void decompose(const Mat4x4& m, ModelInstance& instance) {
+            instance.translation = Vec3{m[3]};
+            Mat3x3 r{m};
+            Vec3 s{glm::length(r[0]), glm::length(r[1]), glm::length(r[2])};
+            if (glm::determinant(r) < 0) s.x = -s.x;
+            for (int i = 0; i < 3; i++) {
+                if (s[i] != 0) r[i] /= s[i];
+            }
+            instance.scale = s;
+            // r = Rz*Ry*Rxglmд
+            float sy = glm::clamp(-r[0][2], -1.f, 1.f);
+            float x, y = asin(sy), z;
+            if (fabs(sy) < 0.99999f) {
+                x = atan2(r[1][2], r[2][2]);
+                z = atan2(r[0][1], r[0][0]);
+            }
+            else {
+                x = 0;
+                z = atan2(-r[1][0], r[1][1]);
+            }
+            instance.rotation = glm::degrees(Vec3{x, y, z});
+        }
+
+        // glTFĵ
+        // ʡ񡢳ڵ˳׷ӵʲУʱɵ߻ع
+        class Loader
+        {
+        private:
+            Asset& asset;
+            const JsonValue& root;
+            string path;                        // ļ·ͼ±Ƕͼȥؼ
+            string directory;                   // ļĿ¼ⲿԴ·
+            vector<string_view> buffers;        // 
+            vector<MappedFile> bufferFiles;     // ⲿļӳ
+            list<string> decodedBuffers;        // data URIõĻ
+            // Ļ֮ʱȴڽͼ
+            AsyncTextureLoader textureLoader;
+
+            // ǰʲб
+            size_t beginModel, beginMaterial;
+
+            // ʵĻɫͼɺٰ󶨵
+            struct TextureRequest
+            {
+                size_t material;    // ±
+                size_t image;       // ͼ±
+            };
+            vector<TextureRequest> textureRequests;
+            vector<shared_future<SharedTexture>> images;    // ͼ±꣬δõͼ񲻽
+            Handle defaultMaterial;                 // δָʵͼԪʹõĲʣ贴
+
+            bool fail(const string& message) {
+                if (error.empty()) error = message;
+                return false;
+            }
+
+            // λͼbyteStrideȱʡʱstrideΪ0
+            bool bufferView(const JsonValue& index, string_view& out, size_t& stride) {
+                auto& views = root["bufferViews"];
+                size_t i, buffer, offset, length;
+                if (!indexOf(index, views.size(), i)) return fail("Invalid buffer view index.");
+                auto& view = views[i];
+                if (!indexOf(view["buffer"], buffers.size(), buffer)
+                    || !sizeOf(view["byteOffset"], 0, offset)
+                    || !view["byteLength"].isNumber() || !sizeOf(view["byteLength"], 0, length)
+                    || !sizeOf(view["byteStride"], 0, stride)) {
+                    return fail("Invalid buffer view.");
+                }
+                auto data = buffers[buffer];
+                if (offset > data.size() || length > data.size() - offset) return fail("Buffer view is out of range.");
+                out = data.substr(offset, length);
+                return true;
+            }
+
+            bool accessor(const JsonValue& index, Accessor& out) {
+                auto& accessors = root["accessors"];
+                size_t i;
+                if (!indexOf(index, accessors.size(), i)) return fail("Invalid accessor index.");
+                auto& a = accessors[i];
+                if (a.has("sparse")) return fail("Sparse accessors are not supported.");
+                if (!a.has("bufferView")) return fail("Accessors without buffer view are not supported.");
+                string_view view;
+                size_t viewStride, offset;
+                if (!bufferView(a["bufferView"], view, viewStride)) return false;
+                out.componentType = uint32_t(a["componentType"].asNumber());
+                out.components = componentCount(a["type"].asString());
+                out.normalized = a["normalized"].asBool();
+                size_t elementSize = componentSize(out.componentType)*out.components;
+                if (elementSize == 0 || !sizeOf(a["byteOffset"], 0, offset)
+                    || !a["count"].isNumber() || !sizeOf(a["count"], 0, out.count)) {
+                    return fail("Invalid accessor.");
+                }
+                out.stride = viewStride != 0 ? viewStride : elementSize;
+                if (out.count != 0) {
+                    if (offset > view.size() || view.size() - offset < elementSize
+                        || (view.size() - offset - elementSize)/out.stride < out.count - 1) {
+                        return fail("Accessor is out of range.");
+                    }
+                }
+                out.data = view.data() + offset;
+                return true;
+            }
+
+            // ȡⲿļdata URIڵڼ䱣Ч
+            bool resource(const string& uri, string_view& out) {
+                if (uri.compare(0, 5, "data:") == 0) {
+                    auto comma = uri.find(',');
+                    if (comma == string::npos || uri.rfind(";base64", comma) == string::npos) return fail("Unsupported data URI.");
+                    decodedBuffers.emplace_back();
+                    if (!decodeBase64(string_view(uri).substr(comma + 1), decodedBuffers.back())) return fail("Invalid base64 data.");
+                    out = decodedBuffers.back();
+                    return true;
+                }
+                MappedFile file(directory + uri);
+                if (!file.isOpen()) return fail("Cannot open " + uri);
+                out = string_view(file.data(), file.size());
+                bufferFiles.push_back(move(file));
+                return true;
+            }
+
+        public:
+            string error;
+
+            Loader(Asset& asset, const JsonValue& root, const string& path)
+                : asset             (asset)
+                , root              (root)
+                , path              (path)
+                , directory         (path.substr(0, path.find_last_of("\\/") + 1))
+                , beginModel        (asset.modelItems.size())
+                , beginMaterial     (asset.materialItems.size())
+            {}
+
+            // λûuriĵһ.glbĶƿ
+            bool loadBuffers(string_view binChunk) {
+                auto& items = root["buffers"];
+                for (size_t i = 0; i < items.size(); i++) {
+                    auto& buffer = items[i];
+                    size_t length;
+                    if (!sizeOf(buffer["byteLength"], 0, length)) return fail("Invalid buffer.");
+                    string_view data;
+                    if (buffer.has("uri")) {
+                        if (!resource(buffer["uri"].asString(), data)) return false;
+                    }
+                    else if (i == 0) {
+                        data = binChunk;
+                    }
+                    if (data.size() < length) return fail("Buffer is truncated.");
+                    buffers.push_back(data.substr(0, length));
+                }
+                return true;
+            }
+
+            // -ֲڶȲʽΪPhongʣ
+            // Ȼ߹ɫֲڶȰBlinn-PhongĵЧϵΪ߹ָ
+            bool loadMaterials() {
+                using PW = Property::Wrapper;
+                auto& items = root["materials"];
+                for (size_t i = 0; i < items.size(); i++) {
+                    auto& m = items[i];
+                    auto& pbr = m["pbrMetallicRoughness"];
+                    Vec4 baseColor = floats(pbr["baseColorFactor"], Vec4{1, 1, 1, 1});
+                    float metallic = glm::clamp(float(pbr["metallicFactor"].asNumber(1)), 0.f, 1.f);
+                    float roughness = glm::clamp(float(pbr["roughnessFactor"].asNumber(1)), 0.f, 1.f);
+                    float alpha = max(roughness*roughness, 1e-2f);
+
+                    MaterialItem item;
+                    item.name = m["name"].isString() ? m["name"].asString() : "material" + to_string(i);
+                    item.material = make_shared<Material>();
+                    item.material->type = 1;
+                    Vec3 base{baseColor};
+                    item.material->registerProperty("diffuseColor", PW::RGBType{base*(1 - metallic)});
+                    item.material->registerProperty("specularColor", PW::RGBType{glm::mix(Vec3{0.04f}, base, metallic)});
+                    item.material->registerProperty("specularEx", PW::FloatType{max(2/(alpha*alpha) - 2, 1.f)});
+
+                    auto& texture = pbr["baseColorTexture"]["index"];
+                    if (!texture.isNull()) {
+                        size_t t, image;
+                        auto& textures = root["textures"];
+                        if (!indexOf(texture, textures.size(), t) || !indexOf(textures[t]["source"], root["images"].size(), image)) {
+                            return fail("Invalid texture in material " + item.name);
+                        }
+                        textureRequests.push_back({ asset.materialItems.size(), image });
+                    }
+                    asset.materialItems.push_back(move(item));
+                }
+                return true;
+            }
+
+            // Ĺ߳н뱻õͼݵĸͬʱ
+            bool decodeImages() {
+                auto& items = root["images"];
+                images.resize(items.size());
+                for (auto& request : textureRequests) {
+                    auto& slot = images[request.image];
+                    if (slot.valid()) continue;
+                    auto& image = items[request.image];
+                    auto& uri = image["uri"].asString();
+                    string_view data;
+                    if (image.has("bufferView")) {
+                        size_t stride;
+                        if (!bufferView(image["bufferView"], data, stride)) return false;
+                    }
+                    else if (uri.compare(0, 5, "data:") == 0) {
+                        if (!resource(uri, data)) return false;
+                    }
+                    else {
+                        slot = textureLoader.request(directory + uri);
+                        continue;
+                    }
+                    slot = textureLoader.request(path + "#image" + to_string(request.image), data.data(), data.size());
+                }
+                return true;
+            }
+
+            // ÿglTFΪһɼģͣÿͼԪһڵ
+            bool loadMeshes() {
+                auto& items = root["meshes"];
+                for (size_t i = 0; i < items.size(); i++) {
+                    auto& m = items[i];
+                    ModelItem modelItem;
+                    modelItem.name = m["name"].isString() ? m["name"].asString() : "mesh" + to_string(i);
+                    modelItem.model = make_shared<Model>();
+                    modelItem.model->visible = false;
+
+                    auto& primitives = m["primitives"];
+                    for (size_t k = 0; k < primitives.size(); k++) {
+                        auto& primitive = primitives[k];
+                        auto mode = uint32_t(primitive["mode"].asNumber(TRIANGLES));
+                        // ͼԪû
+                        if (mode != TRIANGLES && mode != TRIANGLE_STRIP && mode != TRIANGLE_FAN) continue;
+
+                        auto& attributes = primitive["attributes"];
+                        auto mesh = make_shared<Mesh>();
+                        Accessor a;
+                        if (!attributes.has("POSITION")) return fail("Primitive has no positions in mesh " + modelItem.name);
+                        if (!accessor(attributes["POSITION"], a)) return false;
+                        if (!readFloats(a, mesh->positions)) return fail("Unsupported position format in mesh " + modelItem.name);
+                        auto vertexCount = mesh->positions.size();
+                        if (attributes.has("NORMAL")) {
+                            if (!accessor(attributes["NORMAL"], a)) return false;
+                            if (!readFloats(a, mesh->normals) || mesh->normals.size() != vertexCount) {
+                                return fail("Unsupported normal format in mesh " + modelItem.name);
+                            }
+                        }
+                        if (attributes.has("TEXCOORD_0")) {
+                            if (!accessor(attributes["TEXCOORD_0"], a)) return false;
+                            if (!readFloats(a, mesh->uvs) || mesh->uvs.size() != vertexCount) {
+                                return fail("Unsupported texture coordinate format in mesh " + modelItem.name);
+                            }
+                        }
+
+                        // glTFĶԹһ
+                        auto& indices = mesh->positionIndices;
+                        if (primitive.has("indices")) {
+                            if (!accessor(primitive["indices"], a)) return false;
+                            if (!readIndices(a, indices)) return fail("Unsupported index format in mesh " + modelItem.name);
+                            for (auto index : indices) {
+                                if (index >= vertexCount) return fail("Invalid vertex index in mesh " + modelItem.name);
+                            }
+                        }
+                        else {
+                            indices.resize(vertexCount);
+                            for (size_t v = 0; v < vertexCount; v++) indices[v] = Index(v);
+                        }
+                        toTriangleList(mode, indices);
+                        if (mesh->hasNormal()) mesh->normalIndices = indices;
+                        if (mesh->hasUv()) mesh->uvIndices = indices;
+
+                        if (primitive.has("material")) {
+                            size_t material;
+                            if (!indexOf(primitive["material"], root["materials"].size(), material)) {
+                                return fail("Invalid material in mesh " + modelItem.name);
+                            }
+                            mesh->material.setIndex((unsigned int)(beginMaterial + material));
+                        }
+                        else {
+                            mesh->material = getDefaultMaterial();
+                        }
+
+                        NodeItem nodeItem;
+                        nodeItem.name = modelItem.name + "." + to_string(k);
+                        nodeItem.node = make_shared<Node>();
+                        nodeItem.node->type = Node::Type::MESH;
+                        nodeItem.node->model = Index(asset.modelItems.size());
+                        nodeItem.node->entity = Index(asset.meshes.size());
+                        modelItem.model->nodes.push_back(Index(asset.nodeItems.size()));
+                        asset.meshes.push_back(mesh);
+                        asset.nodeItems.push_back(move(nodeItem));
+                    }
+                    asset.modelItems.push_back(move(modelItem));
+                }
+                return true;
+            }
+
+            // glTFδָʱʹðɫ
+            Handle getDefaultMaterial() {
+                if (!defaultMaterial.valid()) {
+                    using PW = Property::Wrapper;
+                    MaterialItem item;
+                    item.name = "default";
+                    item.material = make_shared<Material>();
+                    item.material->type = 0;
+                    item.material->registerProperty("diffuseColor", PW::RGBType{RGB{1, 1, 1}});
+                    defaultMaterial.setIndex((unsigned int)asset.materialItems.size());
+                    asset.materialItems.push_back(move(item));
+                }
+                return defaultMaterial;
+            }
+
+            // ĬϳĽڵÿڵһʵ
+            bool loadNodes() {
+                auto& nodes = root["nodes"];
+                vector<size_t> roots;
+                auto& scenes = root["scenes"];
+                if (scenes.size() != 0) {
+                    size_t scene = 0;
+                    if (root.has("scene") && !indexOf(root["scene"], scenes.size(), scene)) return fail("Invalid default scene.");
+                    auto& sceneNodes = scenes[scene]["nodes"];
+                    for (size_t i = 0; i < sceneNodes.size(); i++) {
+                        size_t n;
+                        if (!indexOf(sceneNodes[i], nodes.size(), n)) return fail("Invalid node index.");
+                        roots.push_back(n);
+                    }
+                }
+                else {
+                    // ûгʱвӽڵĽڵΪ
+                    vector<bool> isChild(nodes.size(), false);
+                    for (size_t i = 0; i < nodes.size(); i++) {
+                        auto& children = nodes[i]["children"];
+                        for (size_t c = 0; c < children.size(); c++) {
+                            size_t n;
+                            if (indexOf(children[c], nodes.size(), n)) isChild[n] = true;
+                        }
+                    }
+                    for (size_t i = 0; i < nodes.size(); i++) {
+                        if (!isChild[i]) roots.push_back(i);
+                    }
+                }
+
+                // ȱڵеĽڵ౻һΣΪл
+                vector<bool> visited(nodes.size(), false);
+                vector<pair<size_t, Mat4x4>> stack;
+                for (auto it = roots.rbegin(); it != roots.rend(); it++) stack.push_back({ *it, Mat4x4{1} });
+                auto meshCount = root["meshes"].size();
+                while (!stack.empty()) {
+                    auto [n, parent] = stack.back();
+                    stack.pop_back();
+                    if (visited[n]) return fail("Node hierarchy is not a tree.");
+                    visited[n] = true;
+                    auto& node = nodes[n];
+
+                    Mat4x4 local{1};
+                    if (node.has("matrix")) {
+                        auto& matrix = node["matrix"];
+                        for (int c = 0; c < 4; c++) {
+                            for (int r = 0; r < 4; r++) {
+                                local[c][r] = float(matrix[size_t(c*4 + r)].asNumber(c == r ? 1 : 0));
+                            }
+                        }
+                    }
+                    else {
+                        Vec3 t = floats(node["translation"], Vec3{0, 0, 0});
+                        Vec4 q = floats(node["rotation"], Vec4{0, 0, 0, 1});
+                        Vec3 s = floats(node["scale"], Vec3{1, 1, 1});
+                        local = glm::translate(local, t);
+                        local = local*glm::mat4_cast(glm::quat{q.w, q.x, q.y, q.z});
+                        local = glm::scale(local, s);
+                    }
+                    Mat4x4 world = parent*local;
+
+                    if (node.has("mesh")) {
+                        size_t mesh;
+                        if (!indexOf(node["mesh"], meshCount, mesh)) return fail("Invalid mesh index in node.");
+                        InstanceItem item;
+                        auto& modelItem = asset.modelItems[beginModel + mesh];
+                        item.name = node["name"].isString() ? node["name"].asString() : modelItem.name;
+                        item.instance = make_shared<ModelInstance>();
+                        item.instance->model = Index(beginModel + mesh);
+                        decompose(world, *item.instance);
+                        asset.instanceItems.push_back(move(item));
+                    }
+
+                    auto& children = node["children"];
+                    for (size_t c = children.size(); c-- > 0;) {
+                        size_t child;
+                        if (!indexOf(children[c], nodes.size(), child)) return fail("Invalid child node index.");
+                        stack.push_back({ child, world });
+                    }
+                }
+                return true;
+            }
+
+            // ȴͼɣΪɹͼ񴴽󶨵ʵͼ
+            // ʧܵͼOBJһ
+            void bindTextures() {
+                using PW = Property::Wrapper;
+                auto& items = root["images"];
+                vector<Handle> handles(images.size());
+                for (size_t i = 0; i < images.size(); i++) {
+                    if (!images[i].valid()) continue;
+                    auto texture = images[i].get();
+                    if (texture == nullptr) continue;
+                    TextureItem ti;
+                    auto& image = items[i];
+                    ti.name = image["name"].isString() ? image["name"].asString()
+                        : (image["uri"].isString() && image["uri"].asString().compare(0, 5, "data:") != 0 ? image["uri"].asString() : "image" + to_string(i));
+                    ti.texture = texture;
+                    ti.glId = GlImage::loadTexture(*texture);
+                    handles[i].setIndex((unsigned int)asset.textureItems.size());
+                    asset.textureItems.push_back(move(ti));
+                }
+                for (auto& request : textureRequests) {
+                    if (!handles[request.image].valid()) continue;
+                    Property p{ "diffuseMap", PW::TextureIdType{handles[request.image]} };
+                    asset.materialItems[request.material].material->registerProperty(p);
+                }
+            }
+        };
+    }
+
+    // glTFļ
+    // asset: ʲ
+    // path: ļ·
+    // ֵ: Ƿɹ
+    bool GlbImporter::import(Asset& asset, const string& path) {
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            lastErrorInfo = "File does not exist!";
+            return false;
+        }
+
+        // .glb12ֽļͷJSONѡĶƿ飻.gltfJSONı
+        string_view json{file.data(), file.size()};
+        string_view binChunk{};
+        uint32_t header[3] = {};
+        if (file.size() >= sizeof(header)) memcpy(header, file.data(), sizeof(header));
+        if (header[0] == glbMagic) {
+            if (header[1] != glbVersion) {
+                lastErrorInfo = "Unsupported glTF version: " + to_string(header[1]);
+                return false;
+            }
+            if (header[2] > file.size()) {
+                lastErrorInfo = "glTF file is truncated!";
+                return false;
+            }
+            json = {};
+            size_t offset = sizeof(header);
+            while (offset + 8 <= header[2]) {
+                uint32_t chunk[2];
+                memcpy(chunk, file.data() + offset, sizeof(chunk));
+                offset += sizeof(chunk);
+                if (chunk[0] > header[2] - offset) {
+                    lastErrorInfo = "glTF file is truncated!";
+                    return false;
+                }
+                string_view data{file.data() + offset, chunk[0]};
+                if (chunk[1] == chunkJson && json.empty()) json = data;
+                else if (chunk[1] == chunkBin && binChunk.empty()) binChunk = data;
+                // 鳤Ȱ4ֽڶ
+                offset += (size_t(chunk[0]) + 3) & ~size_t(3);
+            }
+            if (json.empty()) {
+                lastErrorInfo = "glTF file has no JSON chunk!";
+                return false;
+            }
+        }
+
+        string jsonError;
+        auto root = JsonValue::parse(json, jsonError);
+        if (!root || !root->isObject()) {
+            lastErrorInfo = "Invalid glTF JSON: " + jsonError;
+            return false;
+        }
+        if ((*root)["asset"]["version"].asString().compare(0, 2, "2.") != 0) {
+            lastErrorInfo = "Unsupported glTF version: " + (*root)["asset"]["version"].asString();
+            return false;
+        }
+        if ((*root)["extensionsRequired"].size() != 0) {
+            lastErrorInfo = "Unsupported glTF extension: " + (*root)["extensionsRequired"][size_t(0)].asString();
+            return false;
+        }
+
+        // ¼ǰʲ״̬
+        size_t beginModel = asset.modelItems.size();
+        size_t beginNode = asset.nodeItems.size();
+        size_t beginInstance = asset.instanceItems.size();
+        size_t beginMaterial = asset.materialItems.size();
+        size_t beginTexture = asset.textureItems.size();
+        size_t beginMsh = asset.meshes.size();
+
+        Loader loader(asset, *root, path);
+        bool successFlag = loader.loadBuffers(binChunk)
+            && loader.loadMaterials()
+            && loader.decodeImages()
+            && loader.loadMeshes()
+            && loader.loadNodes();
+
+        if (successFlag) {
+            loader.bindTextures();
+            // ΪӵĽڵOpenGLԤ
+            for (auto i = beginNode; i < asset.nodeItems.size(); i++) {
+                asset.genPreviewGlBuffersPerNode(asset.nodeItems[i]);
+            }
+        }
+        else {
+            lastErrorInfo = loader.error;
+        }
+
+        // ʧܣعи
+        if (!successFlag) {
+            asset.modelItems        .erase(asset.modelItems         .begin() + beginModel,      asset.modelItems.end());
+            asset.nodeItems         .erase(asset.nodeItems          .begin() + beginNode,       asset.nodeItems.end());
+            asset.instanceItems     .erase(asset.instanceItems      .begin() + beginInstance,   asset.instanceItems.end());
+            asset.materialItems     .erase(asset.materialItems      .begin() + beginMaterial,   asset.materialItems.end());
+            asset.textureItems      .erase(asset.textureItems       .begin() + beginTexture,    asset.textureItems.end());
+            asset.meshes            .erase(asset.meshes             .begin() + beginMsh,        asset.meshes.end());
+        }
+
+        return successFlag;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,400 @@
+// Ƴļʵļ
+// ļڴӳ䷽ʽ򿪣ֶαλֶΣ鸴ƣı༶Զɡ
+// 뵽ǿʲʱļе±궼϶Ӧʲбԭеĳ
+
+#include "importer/NrsImporter.hpp"
+#include "importer/NrsFormat.hpp"
+#include "utilities/MappedFile.hpp"
+
+namespace NRenderer
+{
+    using namespace Nrs;
+
+    namespace
+    {
+        // ֶļеļ¼ڼ±
+        struct Counts
+        {
+            uint32_t of[sectionTypeCount] = {};
+            uint32_t operator[](Section s) const { return of[size_t(s)]; }
+        };
+
+        // ǰʲбĳȣļ±0Ӧλ
+        struct Bases
+        {
+            size_t model, node, instance, material, texture;
+            size_t sphere, triangle, plane, mesh;
+            size_t light, point, area, directional, spot;
+        };
+
+        // ȡƫƣcountΪļжӦʲԽʱʧ
+        bool readHandle(Reader& r, uint32_t count, size_t base, Handle& handle) {
+            auto value = r.pod<uint64_t>();
+            if (value > count) return false;
+            handle = Handle{};
+            if (value != 0) handle.setValue(size_t(value) + base);
+            return true;
+        }
+
+        bool readMaterials(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            using PT = Property::Type;
+            using PW = Property::Wrapper;
+            for (uint32_t i = 0; i < counts[Section::MATERIALS] && r.ok(); i++) {
+                MaterialItem item;
+                item.name = r.str();
+                item.material = make_shared<Material>();
+                item.material->type = r.pod<uint32_t>();
+                auto propCount = r.pod<uint32_t>();
+                for (uint32_t k = 0; k < propCount && r.ok(); k++) {
+                    auto key = r.str();
+                    auto type = PT(r.pod<uint32_t>());
+                    auto& props = item.material->properties;
+                    switch (type) {
+                        case PT::INT:           props.push_back({key, PW::IntType{r.pod<int32_t>()}}); break;
+                        case PT::FLOAT:         props.push_back({key, PW::FloatType{r.pod<float>()}}); break;
+                        case PT::RGB:           props.push_back({key, PW::RGBType{r.pod<RGB>()}}); break;
+                        case PT::RGBA:          props.push_back({key, PW::RGBAType{r.pod<RGBA>()}}); break;
+                        case PT::VEC3:          props.push_back({key, PW::Vec3Type{r.pod<Vec3>()}}); break;
+                        case PT::VEC4:          props.push_back({key, PW::Vec4Type{r.pod<Vec4>()}}); break;
+                        case PT::TEXTURE_ID: {
+                            Handle h;
+                            if (!readHandle(r, counts[Section::TEXTURES], bases.texture, h)) return false;
+                            props.push_back({key, PW::TextureIdType{h}});
+                            break;
+                        }
+                        default:
+                            return false;
+                    }
+                }
+                asset.materialItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        // ذ洢ʽ鸴ƣOpenGLȫֶζȡɹٴ
+        bool readTextures(Asset& asset, Reader& r, const Counts& counts) {
+            for (uint32_t i = 0; i < counts[Section::TEXTURES] && r.ok(); i++) {
+                TextureItem item;
+                item.name = r.str();
+                item.glId = 0;
+                auto format = r.pod<uint32_t>();
+                if (format > uint32_t(Texture::Format::RGBA16F)) return false;
+                auto texture = make_shared<Texture>();
+                texture->format = Texture::Format(format);
+                texture->width = r.pod<uint32_t>();
+                texture->height = r.pod<uint32_t>();
+                size_t texelBytes = Texture::bytesPerTexel(texture->format);
+                size_t n = 0;
+                auto pixels = r.array<unsigned char>(n);
+                if (!r.ok()) return false;
+                if (n == 0) {
+                    texture->width = texture->height = 0;
+                }
+                else if (n != size_t(texture->width)*texture->height*texelBytes) {
+                    return false;
+                }
+                else if (texture->format == Texture::Format::RGBA32F) {
+                    texture->rgba = new RGBA[size_t(texture->width)*texture->height];
+                    memcpy(texture->rgba, pixels, n);
+                }
+                else {
+                    texture->packed = make_shared<const vector<unsigned char>>(pixels, pixels + n);
+                }
+                auto levelCount = r.pod<uint32_t>();
+                if (levelCount > 0) {
+                    auto chain = make_shared<vector<MipLevel>>(levelCount);
+                    for (auto& level : *chain) {
+                        level.width = r.pod<uint32_t>();
+                        level.height = r.pod<uint32_t>();
+                        r.array(level.data);
+                        if (!r.ok() || level.data.size() != size_t(level.width)*level.height*texelBytes) return false;
+                    }
+                    texture->mipmaps = move(chain);
+                }
+                item.texture = texture;
+                asset.textureItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        bool readModels(Asset& asset, Reader& r, const Counts& counts, const Bases& bases, uint32_t fileVersion) {
+            for (uint32_t i = 0; i < counts[Section::MODELS] && r.ok(); i++) {
+                ModelItem item;
+                item.name = r.str();
+                item.model = make_shared<Model>();
+                item.model->translation = r.pod<Vec3>();
+                item.model->scale = r.pod<Vec3>();
+                // 汾1ûпɼ־ģͶɼ
+                item.model->visible = fileVersion < 2 || r.pod<uint32_t>() != 0;
+                r.array(item.model->nodes);
+                for (auto& node : item.model->nodes) {
+                    if (node >= counts[Section::NODES]) return false;
+                    node += Index(bases.node);
+                }
+                asset.modelItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        bool readNodes(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::NODES] && r.ok(); i++) {
+                NodeItem item;
+                item.name = r.str();
+                item.node = make_shared<Node>();
+                auto type = r.pod<uint32_t>();
+                auto entity = r.pod<uint32_t>();
+                auto model = r.pod<uint32_t>();
+                if (model >= counts[Section::MODELS]) return false;
+                Section section;
+                size_t base;
+                switch (Node::Type(type)) {
+                    case Node::Type::SPHERE:    section = Section::SPHERES;     base = bases.sphere;    break;
+                    case Node::Type::TRIANGLE:  section = Section::TRIANGLES;   base = bases.triangle;  break;
+                    case Node::Type::PLANE:     section = Section::PLANES;      base = bases.plane;     break;
+                    case Node::Type::MESH:      section = Section::MESHES;      base = bases.mesh;      break;
+                    default: return false;
+                }
+                if (entity >= counts[section]) return false;
+                item.node->type = Node::Type(type);
+                item.node->entity = Index(entity + base);
+                item.node->model = Index(model + bases.model);
+                asset.nodeItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        bool readInstances(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::INSTANCES] && r.ok(); i++) {
+                InstanceItem item;
+                item.name = r.str();
+                item.instance = make_shared<ModelInstance>();
+                auto model = r.pod<uint32_t>();
+                if (model >= counts[Section::MODELS]) return false;
+                item.instance->model = Index(model + bases.model);
+                item.instance->translation = r.pod<Vec3>();
+                item.instance->rotation = r.pod<Vec3>();
+                item.instance->scale = r.pod<Vec3>();
+                asset.instanceItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        bool readSpheres(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::SPHERES] && r.ok(); i++) {
+                auto s = make_shared<Sphere>();
+                if (!readHandle(r, counts[Section::MATERIALS], bases.material, s->material)) return false;
+                s->direction = r.pod<Vec3>();
+                s->position = r.pod<Vec3>();
+                s->radius = r.pod<float>();
+                asset.spheres.push_back(s);
+            }
+            return r.ok();
+        }
+
+        bool readTriangles(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::TRIANGLES] && r.ok(); i++) {
+                auto t = make_shared<Triangle>();
+                if (!readHandle(r, counts[Section::MATERIALS], bases.material, t->material)) return false;
+                for (int k = 0; k < 3; k++) {
+                    t->v[k] = r.pod<Vec3>();
+                }
+                t->normal = r.pod<Vec3>();
+                asset.triangles.push_back(t);
+            }
+            return r.ok();
+        }
+
+        bool readPlanes(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::PLANES] && r.ok(); i++) {
+                auto p = make_shared<Plane>();
+                if (!readHandle(r, counts[Section::MATERIALS], bases.material, p->material)) return false;
+                p->normal = r.pod<Vec3>();
+                p->position = r.pod<Vec3>();
+                p->u = r.pod<Vec3>();
+                p->v = r.pod<Vec3>();
+                asset.planes.push_back(p);
+            }
+            return r.ok();
+        }
+
+        // 鶼ڶӦĶ
+        bool indicesInRange(const vector<Index>& indices, size_t size) {
+            for (auto i : indices) {
+                if (i >= size) return false;
+            }
+            return true;
+        }
+
+        bool readMeshes(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::MESHES] && r.ok(); i++) {
+                auto m = make_shared<Mesh>();
+                if (!readHandle(r, counts[Section::MATERIALS], bases.material, m->material)) return false;
+                r.array(m->normals);
+                r.array(m->positions);
+                r.array(m->uvs);
+                r.array(m->normalIndices);
+                r.array(m->positionIndices);
+                r.array(m->uvIndices);
+                if (!r.ok()
+                    || !indicesInRange(m->normalIndices, m->normals.size())
+                    || !indicesInRange(m->positionIndices, m->positions.size())
+                    || !indicesInRange(m->uvIndices, m->uvs.size())) {
+                    return false;
+                }
+                asset.meshes.push_back(m);
+            }
+            return r.ok();
+        }
+
+        bool readLights(Asset& asset, Reader& r, const Counts& counts, const Bases& bases) {
+            for (uint32_t i = 0; i < counts[Section::LIGHTS] && r.ok(); i++) {
+                LightItem item;
+                item.name = r.str();
+                auto type = r.pod<uint32_t>();
+                auto entity = r.pod<uint32_t>();
+                Section section;
+                size_t base;
+                switch (Light::Type(type)) {
+                    case Light::Type::POINT:        section = Section::POINT_LIGHTS;        base = bases.point;         break;
+                    case Light::Type::SPOT:         section = Section::SPOT_LIGHTS;         base = bases.spot;          break;
+                    case Light::Type::DIRECTIONAL:  section = Section::DIRECTIONAL_LIGHTS;  base = bases.directional;   break;
+                    case Light::Type::AREA:         section = Section::AREA_LIGHTS;         base = bases.area;          break;
+                    default: return false;
+                }
+                if (entity >= counts[section]) return false;
+                item.light = make_shared<Light>(Light::Type(type));
+                item.light->entity = Index(entity + base);
+                asset.lightItems.push_back(item);
+            }
+            return r.ok();
+        }
+
+        template<typename T>
+        bool readLightBuffer(vector<shared_ptr<T>>& lights, Reader& r, uint32_t count) {
+            for (uint32_t i = 0; i < count && r.ok(); i++) {
+                lights.push_back(make_shared<T>(r.pod<T>()));
+            }
+            return r.ok();
+        }
+    }
+
+    // NRSļ
+    // asset: ʲ
+    // path: ļ·
+    // ֵ: Ƿɹ
+    bool NrsImporter::import(Asset& asset, const string& path) {
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            lastErrorInfo = "File does not exist!";
+            return false;
+        }
+
+        // ļͷ
+        Header header{};
+        if (file.size() < sizeof(Header)) {
+            lastErrorInfo = "Not a NRS file!";
+            return false;
+        }
+        memcpy(&header, file.data(), sizeof(Header));
+        if (memcmp(header.magic, magic, sizeof(magic)) != 0) {
+            lastErrorInfo = "Not a NRS file!";
+            return false;
+        }
+        if (header.version < minVersion || header.version > version) {
+            lastErrorInfo = "Unsupported NRS version: " + to_string(header.version);
+            return false;
+        }
+        if (header.fileSize != file.size()) {
+            lastErrorInfo = "NRS file is truncated!";
+            return false;
+        }
+
+        // ȡֶαʶķֱֶ
+        Reader tableReader(file.data() + sizeof(Header), file.size() - sizeof(Header));
+        Counts counts;
+        SectionEntry entries[sectionTypeCount] = {};
+        for (uint32_t i = 0; i < header.sectionCount; i++) {
+            auto entry = tableReader.pod<SectionEntry>();
+            if (!tableReader.ok() || entry.offset > file.size() || entry.size > file.size() - entry.offset) {
+                lastErrorInfo = "Corrupted NRS section table!";
+                return false;
+            }
+            if (entry.type == 0 || entry.type >= sectionTypeCount) continue;
+            entries[entry.type] = entry;
+            counts.of[entry.type] = entry.count;
+        }
+        auto section = [&](Section s) {
+            auto& entry = entries[size_t(s)];
+            return Reader(file.data() + entry.offset, size_t(entry.size));
+        };
+
+        // ¼ǰʲ״̬
+        Bases bases{
+            asset.modelItems.size(), asset.nodeItems.size(), asset.instanceItems.size(),
+            asset.materialItems.size(), asset.textureItems.size(),
+            asset.spheres.size(), asset.triangles.size(), asset.planes.size(), asset.meshes.size(),
+            asset.lightItems.size(), asset.pointLights.size(), asset.areaLights.size(),
+            asset.directionalLights.size(), asset.spotLights.size()
+        };
+
+        bool successFlag = true;
+        auto read = [&](Section s, auto&& func) {
+            if (!successFlag) return;
+            auto r = section(s);
+            successFlag = func(r);
+            if (!successFlag) lastErrorInfo = "Corrupted NRS section: " + to_string(uint32_t(s));
+        };
+        read(Section::TEXTURES,             [&](Reader& r) { return readTextures(asset, r, counts); });
+        read(Section::MATERIALS,            [&](Reader& r) { return readMaterials(asset, r, counts, bases); });
+        read(Section::MODELS,               [&](Reader& r) { return readModels(asset, r, counts, bases, header.version); });
+        read(Section::NODES,                [&](Reader& r) { return readNodes(asset, r, counts, bases); });
+        read(Section::INSTANCES,            [&](Reader& r) { return readInstances(asset, r, counts, bases); });
+        read(Section::SPHERES,              [&](Reader& r) { return readSpheres(asset, r, counts, bases); });
+        read(Section::TRIANGLES,            [&](Reader& r) { return readTriangles(asset, r, counts, bases); });
+        read(Section::PLANES,               [&](Reader& r) { return readPlanes(asset, r, counts, bases); });
+        read(Section::MESHES,               [&](Reader& r) { return readMeshes(asset, r, counts, bases); });
+        read(Section::LIGHTS,               [&](Reader& r) { return readLights(asset, r, counts, bases); });
+        read(Section::POINT_LIGHTS,         [&](Reader& r) { return readLightBuffer(asset.pointLights, r, counts[Section::POINT_LIGHTS]); });
+        read(Section::AREA_LIGHTS,          [&](Reader& r) { return readLightBuffer(asset.areaLights, r, counts[Section::AREA_LIGHTS]); });
+        read(Section::DIRECTIONAL_LIGHTS,   [&](Reader& r) { return readLightBuffer(asset.directionalLights, r, counts[Section::DIRECTIONAL_LIGHTS]); });
+        read(Section::SPOT_LIGHTS,          [&](Reader& r) { return readLightBuffer(asset.spotLights, r, counts[Section::SPOT_LIGHTS]); });
+
+        // Ϊӵڵ͹ԴOpenGL
+        if (successFlag) {
+            for (auto i = bases.texture; i < asset.textureItems.size(); i++) {
+                auto& item = asset.textureItems[i];
+                if (!item.texture->empty()) item.glId = GlImage::loadTexture(*item.texture);
+            }
+
+            for (auto i = bases.node; i < asset.nodeItems.size(); i++) {
+                asset.genPreviewGlBuffersPerNode(asset.nodeItems[i]);
+            }
+
+            for (auto i = bases.light; i < asset.lightItems.size(); i++) {
+                asset.genPreviewGlBuffersPerLight(asset.lightItems[i]);
+            }
+        }
+
+        // ʧܣعи
+        if (!successFlag) {
+            asset.modelItems        .erase(asset.modelItems         .begin() + bases.model,         asset.modelItems.end());
+            asset.nodeItems         .erase(asset.nodeItems          .begin() + bases.node,          asset.nodeItems.end());
+            asset.instanceItems     .erase(asset.instanceItems      .begin() + bases.instance,      asset.instanceItems.end());
+            asset.materialItems     .erase(asset.materialItems      .begin() + bases.material,      asset.materialItems.end());
+            asset.textureItems      .erase(asset.textureItems       .begin() + bases.texture,       asset.textureItems.end());
+
+            asset.spheres           .erase(asset.spheres            .begin() + bases.sphere,        asset.spheres.end());
+            asset.triangles         .erase(asset.triangles          .begin() + bases.triangle,      asset.triangles.end());
+            asset.planes            .erase(asset.planes             .begin() + bases.plane,         asset.planes.end());
+            asset.meshes            .erase(asset.meshes             .begin() + bases.mesh,          asset.meshes.end());
+
+            asset.lightItems        .erase(asset.lightItems         .begin() + bases.light,         asset.lightItems.end());
+            asset.pointLights       .erase(asset.pointLights        .begin() + bases.point,         asset.pointLights.end());
+            asset.areaLights        .erase(asset.areaLights         .begin() + bases.area,          asset.areaLights.end());
+            asset.directionalLights .erase(asset.directionalLights  .begin() + bases.directional,   asset.directionalLights.end());
+            asset.spotLights        .erase(asset.spotLights         .begin() + bases.spot,          asset.spotLights.end());
+        }
+
+        return successFlag;
+    }
+}
\ No newline at end of file
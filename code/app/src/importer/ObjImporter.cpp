@@ -3,54 +3,39 @@
 
 #include <fstream>
 #include <sstream>
+#include <charconv>
+#include <cstring>
+#include <string_view>
 
+#include "common/parallel.hpp"
 #include "utilities/File.hpp"
-#include "utilities/ImageLoader.hpp"
 #include "utilities/GlImage.hpp"
+#include "utilities/MappedFile.hpp"
 
 #include "importer/ObjImporter.hpp"
 
 namespace NRenderer
 {
-    // ļ
-    // filePath: ļĿ¼·
-    // fileName: ļ
-    // ֵ: 
-    inline
-    TextureItem loadTexture(const string& filePath, const string& fileName) {
-        ImageLoader imageLoader{};
-        auto pImage = imageLoader.load(filePath+fileName, 4);  // RGBAʽͼ
-        auto& image = *pImage;
-        if (pImage == nullptr) 
-            return {};
-        auto ti = TextureItem{};
-        ti.texture = SharedTexture{new Texture{}};
-        ti.name = fileName;
-        ti.texture->width = image.width;
-        ti.texture->height = image.height;
-        ti.texture->rgba = new RGBA[image.width*image.height];
-        // ͼݵ
-        for (int i = 0; i < image.width * image.height; i++) {
-            ti.texture->rgba[i].r = image.data[i*4];
-            ti.texture->rgba[i].g = image.data[i*4 + 1];
-            ti.texture->rgba[i].b = image.data[i*4 + 2];
-            ti.texture->rgba[i].a = image.data[i*4 + 3];
-        }
-        ti.glId = GlImage::loadImage(ti.texture->rgba, {image.width, image.height});
-        return ti;
-    }
-
     // MTLļ
     // asset: ʲ
     // path: MTLļĿ¼·
     // file: MTLļ
     // mtlMap: Ƶӳ
+    // textureLoader: 
+    // textureRequests: 
     // ֵ: Ƿɹ
-    bool ObjImporter::parseMtl(Asset& asset, const string& path, ifstream& file, unordered_map<string, size_t>& mtlMap) {
+    bool ObjImporter::parseMtl(Asset& asset, const string& path, ifstream& file, unordered_map<string, size_t>& mtlMap,
+        AsyncTextureLoader& textureLoader, vector<TextureRequest>& textureRequests) {
         MaterialItem* currMaterialItem = nullptr;  // ǰڴĲ
 
         using PW = Property::Wrapper;
 
+        // ύͼ룬ȴ
+        auto requestTexture = [&](const string& key, const string& fileName) {
+            if (currMaterialItem == nullptr) return;
+            textureRequests.push_back({ asset.materialItems.size() - 1, key, fileName, textureLoader.request(path + fileName) });
+        };
+
         string currLine;
         string token;
 
@@ -122,33 +107,15 @@ namespace NRenderer
             }
             else if (token == "map_kd") {  // ͼ
                 ss>>token;
-                auto ti = loadTexture(path, token);
-                if (ti.texture != nullptr) {
-                    Handle t{ (unsigned int)asset.textureItems.size() };
-                    Property p{ "diffuseMap", PW::TextureIdType{t} };
-                    currMaterialItem->material->registerProperty(p);
-                    asset.textureItems.push_back(ti);
-                }
+                requestTexture("diffuseMap", token);
             }
             else if (token == "map_ks") {  // 淴ͼ
                 ss>>token;
-                auto ti = loadTexture(path, token);
-                if (ti.texture != nullptr) {
-                    Handle t{ (unsigned int)asset.textureItems.size() };
-                    Property p{ "specularMap", PW::TextureIdType{t} };
-                    currMaterialItem->material->registerProperty(p);
-                    asset.textureItems.push_back(ti);
-                }
+                requestTexture("specularMap", token);
             }
             else if (token == "map_bump" || token == "bump") {  // ͹ͼ
                 ss>>token;
-                auto ti = loadTexture(path, token);
-                if (ti.texture != nullptr) {
-                    Handle t{ (unsigned int)asset.textureItems.size() };
-                    Property p{ "bumpMap", PW::TextureIdType{t} };
-                    currMaterialItem->material->registerProperty(p);
-                    asset.textureItems.push_back(ti);
-                }
+                requestTexture("bumpMap", token);
             }
             ss.clear();
             ss.str("");
@@ -156,13 +123,172 @@ namespace NRenderer
         return successFlag;
     }
 
+    // ı
+    // ǸΪļе0±ꣻڿȼΪOBJ_RELATIVE_BASE+±꣬ϲʱϿ
+    constexpr static int64_t OBJ_NO_INDEX = -1;
+    constexpr static int64_t OBJ_RELATIVE_BASE = INT64_MIN / 2;
+
+    // һıĽ
+    // 黥Բнٰ˳ϲ
+    struct ObjChunk
+    {
+        // Ӱ䣬˳¼
+        struct Statement
+        {
+            enum class Type
+            {
+                OBJECT, USEMTL, MTLLIB
+            };
+            Type type;
+            size_t triangle;    // ʱѽ
+            string name;
+        };
+
+        vector<Vec3> positions;
+        vector<Vec2> uvs;
+        vector<Vec3> normals;
+        // ǻ棬ÿ3㣬ÿλáꡢ
+        vector<int64_t> positionIndices;
+        vector<int64_t> uvIndices;
+        vector<int64_t> normalIndices;
+        vector<Statement> statements;
+        string error;           // ǿձʾʧ
+    };
+
+    static inline bool objIsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static inline const char* objSkipSpace(const char* p, const char* end) {
+        while (p < end && objIsSpace(*p)) p++;
+        return p;
+    }
+
+    // from_charsǰ'+'
+    static inline const char* objParseFloat(const char* p, const char* end, float& value) {
+        p = objSkipSpace(p, end);
+        if (p < end && *p == '+') p++;
+        auto [next, ec] = from_chars(p, end, value);
+        return ec == errc() ? next : nullptr;
+    }
+
+    // һcountΪǰڣе
+    static inline const char* objParseIndex(const char* p, const char* end, size_t count, int64_t& index) {
+        int64_t i = 0;
+        auto [next, ec] = from_chars(p, end, i);
+        if (ec != errc() || i == 0) return nullptr;
+        index = i > 0 ? i - 1 : OBJ_RELATIVE_BASE + int64_t(count) + i;
+        return next;
+    }
+
+    // ȥβհ׺ʣಿ
+    static inline string objRestOfLine(const char* p, const char* end) {
+        p = objSkipSpace(p, end);
+        while (end > p && objIsSpace(*(end - 1))) end--;
+        return string(p, end);
+    }
+
+    // [begin, end)ڵ
+    static void parseObjChunk(const char* begin, const char* end, ObjChunk& chunk) {
+        using S = ObjChunk::Statement;
+        vector<int64_t> faceP, faceT, faceN;
+        const char* line = begin;
+        while (line < end && chunk.error.empty()) {
+            const char* lineEnd = static_cast<const char*>(memchr(line, '\n', size_t(end - line)));
+            if (lineEnd == nullptr) lineEnd = end;
+            const char* p = objSkipSpace(line, lineEnd);
+            const char* keyEnd = p;
+            while (keyEnd < lineEnd && !objIsSpace(*keyEnd)) keyEnd++;
+            string_view key{p, size_t(keyEnd - p)};
+            p = keyEnd;
+
+            if (key == "v") {
+                Vec3 v;
+                for (int i = 0; i < 3 && p; i++) p = objParseFloat(p, lineEnd, v[i]);
+                if (!p) chunk.error = "Invalid vertex: ";
+                else chunk.positions.push_back(v);
+            }
+            else if (key == "vt") {
+                Vec2 t{0, 0};
+                p = objParseFloat(p, lineEnd, t.x);
+                // ڶʡ
+                if (p) {
+                    const char* q = objParseFloat(p, lineEnd, t.y);
+                    if (!q) t.y = 0;
+                }
+                if (!p) chunk.error = "Invalid texture coordinate: ";
+                else chunk.uvs.push_back(t);
+            }
+            else if (key == "vn") {
+                Vec3 n;
+                for (int i = 0; i < 3 && p; i++) p = objParseFloat(p, lineEnd, n[i]);
+                if (!p) chunk.error = "Invalid normal: ";
+                else chunk.normals.push_back(n);
+            }
+            else if (key == "f") {
+                // ֧ vv/tv//nv/t/nΰǻ
+                faceP.clear();
+                faceT.clear();
+                faceN.clear();
+                while (true) {
+                    p = objSkipSpace(p, lineEnd);
+                    if (p >= lineEnd) break;
+                    int64_t vi = OBJ_NO_INDEX, ti = OBJ_NO_INDEX, ni = OBJ_NO_INDEX;
+                    p = objParseIndex(p, lineEnd, chunk.positions.size(), vi);
+                    if (p && p < lineEnd && *p == '/') {
+                        p++;
+                        if (p < lineEnd && *p != '/') p = objParseIndex(p, lineEnd, chunk.uvs.size(), ti);
+                        if (p && p < lineEnd && *p == '/') {
+                            p = objParseIndex(p + 1, lineEnd, chunk.normals.size(), ni);
+                        }
+                    }
+                    if (!p || (p < lineEnd && !objIsSpace(*p))) {
+                        p = nullptr;
+                        break;
+                    }
+                    faceP.push_back(vi);
+                    faceT.push_back(ti);
+                    faceN.push_back(ni);
+                }
+                if (!p || faceP.size() < 3) {
+                    chunk.error = "Invalid face: ";
+                }
+                else {
+                    for (size_t i = 1; i + 1 < faceP.size(); i++) {
+                        for (size_t k : { size_t(0), i, i + 1 }) {
+                            chunk.positionIndices.push_back(faceP[k]);
+                            chunk.uvIndices.push_back(faceT[k]);
+                            chunk.normalIndices.push_back(faceN[k]);
+                        }
+                    }
+                }
+            }
+            else if (key == "o" || key == "g") {
+                chunk.statements.push_back({ S::Type::OBJECT, chunk.positionIndices.size() / 3, objRestOfLine(p, lineEnd) });
+            }
+            else if (key == "usemtl") {
+                chunk.statements.push_back({ S::Type::USEMTL, chunk.positionIndices.size() / 3, objRestOfLine(p, lineEnd) });
+            }
+            else if (key == "mtllib") {
+                chunk.statements.push_back({ S::Type::MTLLIB, chunk.positionIndices.size() / 3, objRestOfLine(p, lineEnd) });
+            }
+            // 䣨ע͡slȣ
+
+            if (!chunk.error.empty()) {
+                chunk.error += string(line, min<size_t>(size_t(lineEnd - line), 64));
+            }
+            line = lineEnd + 1;
+        }
+    }
+
     // OBJļ
+    // ļӳ䵽ڴбֿ߽飬鲢нٰ˳ϲ
     // asset: ʲ
     // path: OBJļ·
     // ֵ: Ƿɹ
     bool ObjImporter::import(Asset& asset, const string& path) {
-        ifstream file(path);
-        if (!file.is_open()) {
+        MappedFile file(path);
+        if (!file.isOpen()) {
             lastErrorInfo = "File does not exist!";
             return false;
         }
@@ -192,228 +318,204 @@ namespace NRenderer
         modelItem.name = modelName;
         modelItem.model = make_shared<Model>();
 
-        string currLine;
-        bool hasMtl = false;
-        
-        string token;
-        stringstream ss{};
+        // бֿ߽飬ÿ1MB
+        constexpr size_t minChunkSize = size_t(1) << 20;
+        const char* data = file.data();
+        size_t size = file.size();
+        size_t chunkCount = parallelThreads(size, minChunkSize);
+        vector<const char*> bounds{ data };
+        for (size_t c = 1; c < chunkCount; c++) {
+            const char* p = max(bounds.back(), data + size*c/chunkCount);
+            const char* newline = static_cast<const char*>(memchr(p, '\n', size_t(data + size - p)));
+            if (newline == nullptr) break;
+            bounds.push_back(newline + 1);
+        }
+        bounds.push_back(data + size);
+        chunkCount = bounds.size() - 1;
 
-        unordered_map<string, size_t> mtlMap;  // Ƶӳ
-        
-        // ݻ
+        vector<ObjChunk> chunks(chunkCount);
+        parallelFor(chunkCount, 1, 0, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; c++) parseObjChunk(bounds[c], bounds[c + 1], chunks[c]);
+        });
+
+        // ƴӸĶݣ¼ÿļе
         vector<Vec3> positions;  // λ
         vector<Vec3> normals;    // 㷨
         vector<Vec2> uvs;        // 
+        vector<size_t> positionBase(chunkCount), uvBase(chunkCount), normalBase(chunkCount);
+        for (size_t c = 0; c < chunkCount; c++) {
+            if (!chunks[c].error.empty()) {
+                successFlag = false;
+                lastErrorInfo = chunks[c].error;
+                break;
+            }
+            positionBase[c] = positions.size();
+            uvBase[c] = uvs.size();
+            normalBase[c] = normals.size();
+            positions.insert(positions.end(), chunks[c].positions.begin(), chunks[c].positions.end());
+            uvs.insert(uvs.end(), chunks[c].uvs.begin(), chunks[c].uvs.end());
+            normals.insert(normals.end(), chunks[c].normals.begin(), chunks[c].normals.end());
+            vector<Vec3>{}.swap(chunks[c].positions);
+            vector<Vec2>{}.swap(chunks[c].uvs);
+            vector<Vec3>{}.swap(chunks[c].normals);
+        }
 
-        // ӳ
-        using _mp = shared_ptr<unordered_map<Index, Index>>;
-        _mp pMap{nullptr};  // λӳ
-        _mp tMap{nullptr};  // ӳ
-        _mp nMap{nullptr};  // ӳ
+        // ӳ䣺ļе±굽ǰе±
+        // ýڵűӳǷڵǰлʱ
+        vector<unsigned int> pStamp(positions.size(), 0), tStamp(uvs.size(), 0), nStamp(normals.size(), 0);
+        vector<Index> pMap(positions.size()), tMap(uvs.size()), nMap(normals.size());
+        unsigned int currStamp = 0;
 
+        unordered_map<string, size_t> mtlMap;  // Ƶӳ
+        AsyncTextureLoader textureLoader;  // ͼںϲݵͬʱ
+        vector<TextureRequest> textureRequests;
         NodeItem* currNodePtr = nullptr;  // ǰĽڵ
-
         Handle currUsedMtl{};  // ǰʹõĲ
 
-        // нOBJļ
-        while (getline(file, currLine)) {
-            ss<<currLine;
-            ss>>token;
-
-            if (token == "mtllib") {  // ʿļ
-                string mtlFileName;
-                ss>>mtlFileName;
-                auto npos = path.find_last_of("\\/");
-                string mtlPath;
-                mtlPath = path.substr(0, npos + 1);
-                auto mtlFilePath = mtlPath + mtlFileName;
-                ifstream mtlFile(mtlFilePath);
-                if (!mtlFile.is_open()) {
-                    successFlag = false;
-                    lastErrorInfo = "Cannot file .mtl file";
-                    break;
-                }
-                successFlag = parseMtl(asset, mtlPath, mtlFile, mtlMap);
-                if (successFlag) {
-                    hasMtl = true;
-                }
-                else {
-                    break;
-                }
-            }
-            else if (token == "usemtl") {  // ʹò
-                string mtlName;
-                ss>>mtlName;
-                auto mtlItr = mtlMap.find(mtlName);
-                if (mtlItr != mtlMap.end()) {
-                    currUsedMtl.setIndex(mtlItr->second);
-                    asset.meshes[currNodePtr->node->entity]->material = currUsedMtl;
-                }
-                else {
-                    successFlag = false;
-                    lastErrorInfo = "Cannot find material: " + mtlName;
-                    break;
-                }
-            }
-            else if (token == "v") {  // λ
-                float f1, f2, f3;
-                ss>>f1>>f2>>f3;
-                positions.push_back({ f1, f2, f3 });
-            }
-            else if (token == "vt") {  // 
-                float f1, f2;
-                ss>>f1>>f2;
-                uvs.push_back({ f1, f2 });
-            }
-            else if (token == "vn") {  // 㷨
-                float f1, f2, f3;
-                ss>>f1>>f2>>f3;
-                normals.push_back({ f1, f2, f3 });
-            }
-            else if (token == "o" || token == "g") {  // 
-                string name;
-                if (ss.eof()) {
-                    name = "undefined";
-                }
-                else {
-                    ss>>name;
-                }
-                // ½ڵ
-                modelItem.model->nodes.push_back(asset.nodeItems.size());
-                asset.nodeItems.push_back({});
-                pMap = make_shared<unordered_map<Index, Index> >();
-                tMap = make_shared<unordered_map<Index, Index> >();
-                nMap = make_shared<unordered_map<Index, Index> >();
-                currNodePtr = &(*(asset.nodeItems.end() - 1));
-                currNodePtr->name = name;
-                currNodePtr->node = make_shared<Node>();
-                currNodePtr->node->type = Node::Type::MESH;
-                currNodePtr->node->model = asset.modelItems.size();
-                currNodePtr->node->entity = asset.meshes.size();
-                asset.meshes.push_back(make_shared<Mesh>());
-            }
-            else if (token == "f") {  // 棨Σ
-                // ûдڵ㣬һĬϽڵ
-                if (currNodePtr == nullptr) {
-                    modelItem.model->nodes.push_back(asset.nodeItems.size());
-                    asset.nodeItems.push_back({});
-                    pMap = make_shared<unordered_map<Index, Index> >();
-                    tMap = make_shared<unordered_map<Index, Index> >();
-                    nMap = make_shared<unordered_map<Index, Index> >();
-                    currNodePtr = &(*(asset.nodeItems.end() - 1));
-                    currNodePtr->name = "Undefined";
-                    currNodePtr->node = make_shared<Node>();
-                    currNodePtr->node->type = Node::Type::MESH;
-                    currNodePtr->node->model = asset.modelItems.size();
-                    currNodePtr->node->entity = asset.meshes.size();
-                    asset.meshes.push_back(make_shared<Mesh>());
-                }
-
-                long v{0}, t{0}, n{0};  // 㡢
-                char c = '\0';
-
-                exception e(".obj file must be triangulated.");
-
-                Index vpi[3];  // λ
-                Index vti[3];  // 
-                Index vni[3];  // 㷨
-
-                // ε
-                for (int i=0; i<3; i++) {
-                    vpi[i] = -1;
-                    vti[i] = -1;
-                    vni[i] = -1;
-
-                    if(ss.eof()) throw e;
-
-                    string vertexToken;
-                    ss>>vertexToken;
-                    stringstream vertexStream{vertexToken};
-                    auto begin = vertexToken.find_first_of('/');
-                    auto end = vertexToken.find_last_of('/');
-
-                    // ͬʽĶ
-                    // f v v v
-                    if (begin == vertexToken.npos) {
-                        vertexStream>>v;
-                        t = -1;
-                        n = -1;
-                    }
-                    // f v/t v/t v/t
-                    else if (begin == end) {
-                        vertexStream>>v>>c>>t;
-                        n = -1;
+        // ½ڵ
+        auto newNode = [&](const string& name) {
+            modelItem.model->nodes.push_back(asset.nodeItems.size());
+            asset.nodeItems.push_back({});
+            currStamp++;
+            currNodePtr = &(*(asset.nodeItems.end() - 1));
+            currNodePtr->name = name.empty() ? "undefined" : name;
+            currNodePtr->node = make_shared<Node>();
+            currNodePtr->node->type = Node::Type::MESH;
+            currNodePtr->node->model = asset.modelItems.size();
+            currNodePtr->node->entity = asset.meshes.size();
+            asset.meshes.push_back(make_shared<Mesh>());
+            asset.meshes.back()->material = currUsedMtl;
+        };
+
+        // ļе±Ϊļе±꣬Խȱʡʱfalse
+        auto resolve = [](int64_t index, size_t base, size_t count, size_t& result) {
+            if (index == OBJ_NO_INDEX) return false;
+            int64_t global = index >= 0 ? index : index - OBJ_RELATIVE_BASE + int64_t(base);
+            if (global < 0 || uint64_t(global) >= count) return false;
+            result = size_t(global);
+            return true;
+        };
+
+        // ˳ϲ
+        for (size_t c = 0; c < chunkCount && successFlag; c++) {
+            auto& chunk = chunks[c];
+            size_t triangleCount = chunk.positionIndices.size() / 3;
+            size_t statement = 0;
+            for (size_t tri = 0; tri <= triangleCount && successFlag; tri++) {
+                // ֮ǰ
+                for (; statement < chunk.statements.size() && chunk.statements[statement].triangle == tri; statement++) {
+                    auto& s = chunk.statements[statement];
+                    using T = ObjChunk::Statement::Type;
+                    if (s.type == T::MTLLIB) {  // ʿļ
+                        auto npos = path.find_last_of("\\/");
+                        string mtlPath;
+                        mtlPath = path.substr(0, npos + 1);
+                        auto mtlFilePath = mtlPath + s.name;
+                        ifstream mtlFile(mtlFilePath);
+                        if (!mtlFile.is_open()) {
+                            successFlag = false;
+                            lastErrorInfo = "Cannot file .mtl file";
+                            break;
+                        }
+                        successFlag = parseMtl(asset, mtlPath, mtlFile, mtlMap, textureLoader, textureRequests);
+                        if (!successFlag) break;
                     }
-                    // f v//n v//n v//n
-                    else if (begin + 1 == end) {
-                        vertexStream>>v>>c>>c>>n;
-                        t = -1;
+                    else if (s.type == T::USEMTL) {  // ʹò
+                        auto mtlItr = mtlMap.find(s.name);
+                        if (mtlItr == mtlMap.end()) {
+                            successFlag = false;
+                            lastErrorInfo = "Cannot find material: " + s.name;
+                            break;
+                        }
+                        currUsedMtl.setIndex(mtlItr->second);
+                        if (currNodePtr != nullptr) {
+                            asset.meshes[currNodePtr->node->entity]->material = currUsedMtl;
+                        }
                     }
-                    // f v/t/n v/t/n v/t/n
-                    else {
-                        vertexStream>>v>>c>>t>>c>>n;
+                    else {  // 
+                        newNode(s.name);
                     }
+                }
+                if (!successFlag || tri == triangleCount) break;
 
+                // ûдڵ㣬һĬϽڵ
+                if (currNodePtr == nullptr) {
+                    newNode("Undefined");
+                }
+                auto& mesh = *asset.meshes[currNodePtr->node->entity];
+                for (size_t k = tri*3; k < tri*3 + 3; k++) {
+                    size_t i;
                     // λ
-                    if (v != -1) {
-                        auto finded = pMap->find(v);
-                        if (finded != pMap->end()) {
-                            vpi[i] = finded->second;
-                        }
-                        else {
-                            auto idx = asset.meshes[currNodePtr->node->entity]->positions.size();
-                            vpi[i] = idx;
-                            pMap->insert({v, idx});
-                            asset.meshes[currNodePtr->node->entity]->positions.push_back(positions[v - 1]);
-                        }
-                        asset.meshes[currNodePtr->node->entity]->positionIndices.push_back(vpi[i]);
+                    if (!resolve(chunk.positionIndices[k], positionBase[c], positions.size(), i)) {
+                        successFlag = false;
+                        lastErrorInfo = "Invalid vertex index in face.";
+                        break;
+                    }
+                    if (pStamp[i] != currStamp) {
+                        pStamp[i] = currStamp;
+                        pMap[i] = Index(mesh.positions.size());
+                        mesh.positions.push_back(positions[i]);
                     }
+                    mesh.positionIndices.push_back(pMap[i]);
 
                     // 
-                    if (t != -1) {
-                        auto finded = tMap->find(t);
-                        if (finded != tMap->end()) {
-                            vti[i] = finded->second;
+                    if (chunk.uvIndices[k] != OBJ_NO_INDEX) {
+                        if (!resolve(chunk.uvIndices[k], uvBase[c], uvs.size(), i)) {
+                            successFlag = false;
+                            lastErrorInfo = "Invalid texture coordinate index in face.";
+                            break;
                         }
-                        else {
-                            auto idx = asset.meshes[currNodePtr->node->entity]->uvs.size();
-                            vti[i] = idx;
-                            tMap->insert({t, idx});
-                            asset.meshes[currNodePtr->node->entity]->uvs.push_back(uvs[t - 1]);
+                        if (tStamp[i] != currStamp) {
+                            tStamp[i] = currStamp;
+                            tMap[i] = Index(mesh.uvs.size());
+                            mesh.uvs.push_back(uvs[i]);
                         }
-                        asset.meshes[currNodePtr->node->entity]->uvIndices.push_back(vti[i]);
+                        mesh.uvIndices.push_back(tMap[i]);
                     }
 
                     // 
-                    if (n != -1) {
-                        auto finded = nMap->find(n);
-                        if (finded != nMap->end()) {
-                            vni[i] = finded->second;
+                    if (chunk.normalIndices[k] != OBJ_NO_INDEX) {
+                        if (!resolve(chunk.normalIndices[k], normalBase[c], normals.size(), i)) {
+                            successFlag = false;
+                            lastErrorInfo = "Invalid normal index in face.";
+                            break;
                         }
-                        else {
-                            auto idx = asset.meshes[currNodePtr->node->entity]->normals.size();
-                            vni[i] = idx;
-                            nMap->insert({n, idx});
-                            asset.meshes[currNodePtr->node->entity]->normals.push_back(normals[n - 1]);
+                        if (nStamp[i] != currStamp) {
+                            nStamp[i] = currStamp;
+                            nMap[i] = Index(mesh.normals.size());
+                            mesh.normals.push_back(normals[i]);
                         }
-                        asset.meshes[currNodePtr->node->entity]->normalIndices.push_back(vni[i]);
+                        mesh.normalIndices.push_back(nMap[i]);
                     }
                 }
-
-                // ǷΪ
-                if (!ss.eof()) {
-                    successFlag = false;
-                    lastErrorInfo = "Only Triangulated mesh is supported!";
-                    break;
-                }
             }
-            ss.clear();
-            ss.str("");
         }
 
         // ģ͵ʲ
         asset.modelItems.push_back(modelItem);
 
+        // ȴͼɲ󶨵ʣͬһļֻһ
+        // ʧܵͼ֮ǰһ
+        if (successFlag) {
+            using PW = Property::Wrapper;
+            unordered_map<const Texture*, Handle> textureHandles;
+            for (auto& request : textureRequests) {
+                auto texture = request.texture.get();
+                if (texture == nullptr) continue;
+                auto it = textureHandles.find(texture.get());
+                if (it == textureHandles.end()) {
+                    TextureItem ti;
+                    ti.name = request.name;
+                    ti.texture = texture;
+                    ti.glId = GlImage::loadTexture(*texture);
+                    it = textureHandles.emplace(texture.get(), Handle{ (unsigned int)asset.textureItems.size() }).first;
+                    asset.textureItems.push_back(move(ti));
+                }
+                Property p{ request.key, PW::TextureIdType{it->second} };
+                asset.materialItems[request.material].material->registerProperty(p);
+            }
+        }
+
         // ΪӵĽڵOpenGLԤ
         if (successFlag) {
             for (auto i = beginNode; i < asset.nodeItems.size(); i++) {
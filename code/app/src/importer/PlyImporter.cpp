@@ -0,0 +1,513 @@
+// PLYļʵļ
+// ȽıļͷõԪصԲֶٰ֣ȡݣ
+// 㲼񻺳һʱ鸴ƣ̰߳¼ȡȫεԪ̶ͬ߳ȡ
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+#include <initializer_list>
+#include <atomic>
+
+#include "common/parallel.hpp"
+#include "utilities/File.hpp"
+#include "utilities/MappedFile.hpp"
+
+#include "importer/PlyImporter.hpp"
+
+namespace NRenderer
+{
+    namespace
+    {
+        // Եֵ
+        enum class PlyType
+        {
+            INVALID, INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT32, FLOAT64
+        };
+
+        PlyType parseType(string_view s) {
+            if (s == "char" || s == "int8") return PlyType::INT8;
+            if (s == "uchar" || s == "uint8") return PlyType::UINT8;
+            if (s == "short" || s == "int16") return PlyType::INT16;
+            if (s == "ushort" || s == "uint16") return PlyType::UINT16;
+            if (s == "int" || s == "int32") return PlyType::INT32;
+            if (s == "uint" || s == "uint32") return PlyType::UINT32;
+            if (s == "float" || s == "float32") return PlyType::FLOAT32;
+            if (s == "double" || s == "float64") return PlyType::FLOAT64;
+            return PlyType::INVALID;
+        }
+
+        size_t typeSize(PlyType t) {
+            switch (t) {
+                case PlyType::INT8: case PlyType::UINT8: return 1;
+                case PlyType::INT16: case PlyType::UINT16: return 2;
+                case PlyType::INT32: case PlyType::UINT32: case PlyType::FLOAT32: return 4;
+                case PlyType::FLOAT64: return 8;
+                default: return 0;
+            }
+        }
+
+        bool isInteger(PlyType t) {
+            return t != PlyType::INVALID && t != PlyType::FLOAT32 && t != PlyType::FLOAT64;
+        }
+
+        template<typename T>
+        T load(const char* p) {
+            T v;
+            memcpy(&v, p, sizeof(T));
+            return v;
+        }
+
+        // ȡһֵļСţƽ̨һ
+        double readNumber(const char* p, PlyType t) {
+            switch (t) {
+                case PlyType::INT8: return load<int8_t>(p);
+                case PlyType::UINT8: return load<uint8_t>(p);
+                case PlyType::INT16: return load<int16_t>(p);
+                case PlyType::UINT16: return load<uint16_t>(p);
+                case PlyType::INT32: return load<int32_t>(p);
+                case PlyType::UINT32: return load<uint32_t>(p);
+                case PlyType::FLOAT32: return load<float>(p);
+                case PlyType::FLOAT64: return load<double>(p);
+                default: return 0;
+            }
+        }
+
+        // ȡһб붥
+        int64_t readInt(const char* p, PlyType t) {
+            switch (t) {
+                case PlyType::INT8: return load<int8_t>(p);
+                case PlyType::UINT8: return load<uint8_t>(p);
+                case PlyType::INT16: return load<int16_t>(p);
+                case PlyType::UINT16: return load<uint16_t>(p);
+                case PlyType::INT32: return load<int32_t>(p);
+                case PlyType::UINT32: return load<uint32_t>(p);
+                default: return -1;
+            }
+        }
+
+        struct PlyProperty
+        {
+            string name;
+            PlyType type = PlyType::INVALID;        // ͻбԪص
+            PlyType countType = PlyType::INVALID;   // бȵͣΪINVALID
+            size_t offset = 0;                      // ڶ¼еƫ
+
+            bool isList() const {
+                return countType != PlyType::INVALID;
+            }
+        };
+
+        struct PlyElement
+        {
+            string name;
+            size_t count = 0;
+            vector<PlyProperty> properties;
+            size_t size = 0;        // ¼ֽ
+            bool fixed = true;      // Ƿ񲻺бԣÿ¼ȳ
+
+            // ѡƲԣûʱnullptr
+            const PlyProperty* find(initializer_list<const char*> names) const {
+                for (auto name : names) {
+                    for (auto& p : properties) {
+                        if (p.name == name) return &p;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        // ̶߳ȡʱÿ߳ٴļ¼
+        constexpr size_t minItemsPerThread = size_t(1) << 16;
+
+        // ļͷ
+        // bodyOffset: ݵ
+        bool parseHeader(string_view text, vector<PlyElement>& elements, size_t& bodyOffset, string& error) {
+            size_t pos = 0;
+            size_t lineNumber = 0;
+            while (pos < text.size()) {
+                auto newline = text.find('\n', pos);
+                if (newline == string_view::npos) break;
+                auto line = text.substr(pos, newline - pos);
+                pos = newline + 1;
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+                vector<string_view> tokens;
+                for (size_t i = 0; i < line.size();) {
+                    while (i < line.size() && line[i] == ' ') i++;
+                    size_t begin = i;
+                    while (i < line.size() && line[i] != ' ') i++;
+                    if (i > begin) tokens.push_back(line.substr(begin, i - begin));
+                }
+
+                if (lineNumber++ == 0) {
+                    if (tokens.size() != 1 || tokens[0] != "ply") {
+                        error = "Not a PLY file!";
+                        return false;
+                    }
+                    continue;
+                }
+                if (tokens.empty() || tokens[0] == "comment" || tokens[0] == "obj_info") continue;
+                if (tokens[0] == "format") {
+                    if (tokens.size() < 2 || tokens[1] != "binary_little_endian") {
+                        error = "Only binary little-endian PLY files are supported.";
+                        return false;
+                    }
+                }
+                else if (tokens[0] == "element") {
+                    PlyElement e;
+                    if (tokens.size() != 3) {
+                        error = "Invalid PLY element.";
+                        return false;
+                    }
+                    e.name = string(tokens[1]);
+                    auto [next, ec] = from_chars(tokens[2].data(), tokens[2].data() + tokens[2].size(), e.count);
+                    if (ec != errc() || next != tokens[2].data() + tokens[2].size()) {
+                        error = "Invalid PLY element count.";
+                        return false;
+                    }
+                    elements.push_back(move(e));
+                }
+                else if (tokens[0] == "property") {
+                    if (elements.empty()) {
+                        error = "PLY property outside of element.";
+                        return false;
+                    }
+                    auto& e = elements.back();
+                    PlyProperty p;
+                    if (tokens.size() == 5 && tokens[1] == "list") {
+                        p.countType = parseType(tokens[2]);
+                        p.type = parseType(tokens[3]);
+                        p.name = string(tokens[4]);
+                        if (!isInteger(p.countType)) p.type = PlyType::INVALID;
+                        e.fixed = false;
+                    }
+                    else if (tokens.size() == 3) {
+                        p.type = parseType(tokens[1]);
+                        p.name = string(tokens[2]);
+                        p.offset = e.size;
+                        e.size += typeSize(p.type);
+                    }
+                    if (p.type == PlyType::INVALID) {
+                        error = "Invalid PLY property: " + string(line);
+                        return false;
+                    }
+                    e.properties.push_back(move(p));
+                }
+                else if (tokens[0] == "end_header") {
+                    bodyOffset = pos;
+                    return true;
+                }
+                else {
+                    error = "Unknown PLY header line: " + string(line);
+                    return false;
+                }
+            }
+            error = "PLY header is truncated!";
+            return false;
+        }
+
+        // һԪأendΪļĩβԪֱбԪȡ
+        bool skipElement(const PlyElement& e, const char*& p, const char* end) {
+            if (e.fixed) {
+                if (e.size != 0 && size_t(end - p)/e.size < e.count) return false;
+                p += e.count*e.size;
+                return true;
+            }
+            for (size_t i = 0; i < e.count; i++) {
+                for (auto& prop : e.properties) {
+                    size_t bytes = typeSize(prop.type);
+                    if (prop.isList()) {
+                        size_t countSize = typeSize(prop.countType);
+                        if (size_t(end - p) < countSize) return false;
+                        auto n = readInt(p, prop.countType);
+                        if (n < 0) return false;
+                        p += countSize;
+                        bytes *= size_t(n);
+                    }
+                    if (size_t(end - p) < bytes) return false;
+                    p += bytes;
+                }
+            }
+            return true;
+        }
+
+        // ȡ¼еĶάά
+        // ŵĵȸʱƣ¼ʱ鸴
+        template<typename V>
+        void gather(const char* data, size_t stride, const PlyProperty* const* props, vector<V>& out) {
+            constexpr int n = V::length();
+            size_t first = props[0]->offset;
+            bool packed = true;
+            for (int k = 0; k < n; k++) {
+                packed = packed && props[k]->type == PlyType::FLOAT32 && props[k]->offset == first + 4*k;
+            }
+            if (packed && first == 0 && stride == sizeof(V)) {
+                if (!out.empty()) memcpy(out.data(), data, out.size()*sizeof(V));
+                return;
+            }
+            parallelFor(out.size(), minItemsPerThread, 0, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const char* record = data + i*stride;
+                    if (packed) {
+                        memcpy(&out[i], record + first, sizeof(V));
+                    }
+                    else {
+                        for (int k = 0; k < n; k++) {
+                            out[i][k] = float(readNumber(record + props[k]->offset, props[k]->type));
+                        }
+                    }
+                }
+            });
+        }
+
+        // ȡԪزǻ
+        // p: Ԫص㣬ȡƵԪĩβ
+        bool readFaces(const PlyElement& e, const char*& p, const char* end, size_t vertexCount, vector<Index>& indices, string& error) {
+            auto prop = e.find({ "vertex_indices", "vertex_index" });
+            if (prop == nullptr || !prop->isList() || !isInteger(prop->type)) {
+                error = "PLY faces have no vertex index list.";
+                return false;
+            }
+            size_t countSize = typeSize(prop->countType);
+            size_t indexSize = typeSize(prop->type);
+
+            // ԪֻбʱȼٶȫΣ¼̶߳ȡ˻ȡ
+            size_t record = countSize + 3*indexSize;
+            if (e.properties.size() == 1 && size_t(end - p)/record >= e.count) {
+                atomic<bool> triangles{true}, valid{true};
+                indices.resize(e.count*3);
+                parallelFor(e.count, minItemsPerThread, 0, [&](size_t begin, size_t finish) {
+                    for (size_t i = begin; i < finish; i++) {
+                        const char* r = p + i*record;
+                        if (readInt(r, prop->countType) != 3) {
+                            triangles = false;
+                            return;
+                        }
+                        r += countSize;
+                        Index* tri = &indices[i*3];
+                        if (prop->type == PlyType::INT32 || prop->type == PlyType::UINT32) {
+                            // 32λ޷ȡͬԽ
+                            memcpy(tri, r, 3*sizeof(Index));
+                            for (int k = 0; k < 3; k++) {
+                                if (tri[k] >= vertexCount) valid = false;
+                            }
+                        }
+                        else {
+                            for (int k = 0; k < 3; k++) {
+                                auto v = readInt(r + k*indexSize, prop->type);
+                                if (v < 0 || uint64_t(v) >= vertexCount) valid = false;
+                                tri[k] = Index(v);
+                            }
+                        }
+                    }
+                });
+                // жʱ̵߳ļ¼߽粻ţȫ
+                if (triangles) {
+                    if (!valid) {
+                        error = "Invalid vertex index in PLY face.";
+                        return false;
+                    }
+                    p += e.count*record;
+                    return true;
+                }
+                indices.clear();
+            }
+
+            // ļͷʣֽɵԤ
+            indices.reserve(min(e.count, size_t(end - p)/record)*3);
+            vector<Index> polygon;
+            for (size_t i = 0; i < e.count; i++) {
+                for (auto& q : e.properties) {
+                    size_t bytes = typeSize(q.type);
+                    size_t n = 1;
+                    if (q.isList()) {
+                        size_t size = typeSize(q.countType);
+                        if (size_t(end - p) < size) {
+                            error = "PLY file is truncated!";
+                            return false;
+                        }
+                        auto count = readInt(p, q.countType);
+                        if (count < 0) {
+                            error = "Invalid PLY list length.";
+                            return false;
+                        }
+                        p += size;
+                        n = size_t(count);
+                    }
+                    if (size_t(end - p)/bytes < n) {
+                        error = "PLY file is truncated!";
+                        return false;
+                    }
+                    if (&q == prop) {
+                        polygon.resize(n);
+                        for (size_t k = 0; k < n; k++) {
+                            auto v = readInt(p + k*bytes, q.type);
+                            if (v < 0 || uint64_t(v) >= vertexCount) {
+                                error = "Invalid vertex index in PLY face.";
+                                return false;
+                            }
+                            polygon[k] = Index(v);
+                        }
+                        for (size_t k = 1; k + 1 < n; k++) {
+                            indices.push_back(polygon[0]);
+                            indices.push_back(polygon[k]);
+                            indices.push_back(polygon[k + 1]);
+                        }
+                    }
+                    p += n*bytes;
+                }
+            }
+            return true;
+        }
+
+        // Ȩ㶥㷨
+        // ÿ̸߳һζ㣬ֻۼζϵΣΰö±ķΧ
+        // ̵߳ĶβཻĿɨõģδڵĶ㣬ÿֻ߳Ŀ顣
+        // 㰴˳ͣ߳޹أҲҪڽӱ
+        void computeNormals(const vector<Vec3>& positions, const vector<Index>& indices, vector<Vec3>& normals) {
+            constexpr size_t blockSize = 4096;  // ÿ
+            size_t triangleCount = indices.size()/3;
+            size_t blockCount = (triangleCount + blockSize - 1)/blockSize;
+            vector<pair<Index, Index>> blockBounds(blockCount);  // õС󶥵±
+            parallelFor(blockCount, minItemsPerThread/blockSize, 0, [&](size_t begin, size_t end) {
+                for (size_t b = begin; b < end; b++) {
+                    auto bounds = minmax_element(indices.begin() + b*blockSize*3, indices.begin() + min(triangleCount, (b + 1)*blockSize)*3);
+                    blockBounds[b] = { *bounds.first, *bounds.second };
+                }
+            });
+
+            normals.assign(positions.size(), Vec3{0, 0, 0});
+            parallelFor(positions.size(), minItemsPerThread, 0, [&](size_t begin, size_t end) {
+                auto owned = [&](Index v) { return v >= begin && v < end; };
+                for (size_t b = 0; b < blockCount; b++) {
+                    if (blockBounds[b].second < begin || blockBounds[b].first >= end) continue;
+                    size_t last = min(triangleCount, (b + 1)*blockSize);
+                    for (size_t t = b*blockSize; t < last; t++) {
+                        const Index* tri = &indices[t*3];
+                        if (!owned(tri[0]) && !owned(tri[1]) && !owned(tri[2])) continue;
+                        auto& p0 = positions[tri[0]];
+                        Vec3 n = glm::cross(positions[tri[1]] - p0, positions[tri[2]] - p0);
+                        for (int k = 0; k < 3; k++) {
+                            if (owned(tri[k])) normals[tri[k]] += n;
+                        }
+                    }
+                }
+                for (size_t v = begin; v < end; v++) {
+                    float length = glm::length(normals[v]);
+                    normals[v] = length > 0 ? normals[v]/length : Vec3{0, 0, 1};
+                }
+            });
+        }
+    }
+
+    // PLYļ
+    // asset: ʲ
+    // path: ģļ·
+    // ֵ: Ƿɹ
+    bool PlyImporter::import(Asset& asset, const string& path) {
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            lastErrorInfo = "File does not exist!";
+            return false;
+        }
+
+        vector<PlyElement> elements;
+        size_t bodyOffset = 0;
+        if (!parseHeader(string_view(file.data(), file.size()), elements, bodyOffset, lastErrorInfo)) {
+            return false;
+        }
+
+        // ھֲȫȡɹżʲʧʱع
+        auto mesh = make_shared<Mesh>();
+        size_t vertexCount = 0;
+        for (auto& e : elements) {
+            if (e.name == "vertex") vertexCount = e.count;
+        }
+        const PlyElement* vertexElement = nullptr;
+        const char* vertexData = nullptr;
+        const char* p = file.data() + bodyOffset;
+        const char* end = file.data() + file.size();
+        for (auto& e : elements) {
+            if (e.name == "vertex") {
+                if (!e.fixed) {
+                    lastErrorInfo = "PLY vertices with list properties are not supported.";
+                    return false;
+                }
+                vertexElement = &e;
+                vertexData = p;
+            }
+            else if (e.name == "face") {
+                if (!readFaces(e, p, end, vertexCount, mesh->positionIndices, lastErrorInfo)) return false;
+                continue;
+            }
+            if (!skipElement(e, p, end)) {
+                lastErrorInfo = "PLY file is truncated!";
+                return false;
+            }
+        }
+        if (vertexElement == nullptr) {
+            lastErrorInfo = "PLY file has no vertices.";
+            return false;
+        }
+
+        // 
+        auto& v = *vertexElement;
+        const PlyProperty* position[3] = { v.find({"x"}), v.find({"y"}), v.find({"z"}) };
+        if (!position[0] || !position[1] || !position[2]) {
+            lastErrorInfo = "PLY vertices have no position.";
+            return false;
+        }
+        mesh->positions.resize(v.count);
+        gather(vertexData, v.size, position, mesh->positions);
+
+        const PlyProperty* uv[2] = { v.find({"u", "s", "texture_u", "texture_s"}), v.find({"v", "t", "texture_v", "texture_t"}) };
+        if (uv[0] && uv[1]) {
+            mesh->uvs.resize(v.count);
+            gather(vertexData, v.size, uv, mesh->uvs);
+            mesh->uvIndices = mesh->positionIndices;
+        }
+
+        const PlyProperty* normal[3] = { v.find({"nx"}), v.find({"ny"}), v.find({"nz"}) };
+        if (normal[0] && normal[1] && normal[2]) {
+            mesh->normals.resize(v.count);
+            gather(vertexData, v.size, normal, mesh->normals);
+        }
+        else {
+            computeNormals(mesh->positions, mesh->positionIndices, mesh->normals);
+        }
+        mesh->normalIndices = mesh->positionIndices;
+
+        // PLYûвʣʹðɫ
+        using PW = Property::Wrapper;
+        auto modelName = File::getFileName(path);
+        MaterialItem materialItem;
+        materialItem.name = modelName;
+        materialItem.material = make_shared<Material>();
+        materialItem.material->type = 0;
+        materialItem.material->registerProperty("diffuseColor", PW::RGBType{RGB{1, 1, 1}});
+        mesh->material.setIndex((unsigned int)asset.materialItems.size());
+        asset.materialItems.push_back(move(materialItem));
+
+        ModelItem modelItem;
+        modelItem.name = modelName;
+        modelItem.model = make_shared<Model>();
+        modelItem.model->nodes.push_back(Index(asset.nodeItems.size()));
+
+        NodeItem nodeItem;
+        nodeItem.name = modelName;
+        nodeItem.node = make_shared<Node>();
+        nodeItem.node->type = Node::Type::MESH;
+        nodeItem.node->model = Index(asset.modelItems.size());
+        nodeItem.node->entity = Index(asset.meshes.size());
+
+        asset.meshes.push_back(mesh);
+        asset.nodeItems.push_back(move(nodeItem));
+        asset.modelItems.push_back(move(modelItem));
+
+        // ΪӵĽڵOpenGLԤ
+        asset.genPreviewGlBuffersPerNode(asset.nodeItems.back());
+        return true;
+    }
+}
\ No newline at end of file
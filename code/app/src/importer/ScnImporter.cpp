@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include <map>
+#include <algorithm>
 
 namespace NRenderer
 {
@@ -122,6 +123,7 @@ namespace NRenderer
         bool successFlag = true;
 
         int currNodeType = 0;  // ǰڵ
+        bool inInstance = false;  // һǷΪInstanceʱ任ڸʵ
         
         while(getline(file, currline)) {
             ss.str("");
@@ -136,16 +138,52 @@ namespace NRenderer
                 ss>>modelItem.name;
                 modelItem.model = make_shared<Model>();
                 asset.modelItems.push_back(modelItem);
+                inInstance = false;
+            }
+            else if (token == "Instance") {  // ģʵInstance <ģ> [ʵ]
+                string modelName, name;
+                ss>>modelName>>name;
+                // ͬģһ֮ǰĳеģ
+                auto it = find_if(asset.modelItems.rbegin(), asset.modelItems.rend(),
+                    [&modelName](const ModelItem& mi) { return mi.name == modelName; });
+                if (it == asset.modelItems.rend()) {
+                    lastErrorInfo = "Cannot find model to instance: " + modelName;
+                    successFlag = false;
+                    break;
+                }
+                InstanceItem ii{};
+                ii.name = name.empty() ? modelName : name;
+                ii.instance = make_shared<ModelInstance>();
+                ii.instance->model = Index(asset.modelItems.rend() - it - 1);
+                asset.instanceItems.push_back(ii);
+                inInstance = true;
+            }
+            else if (token == "Translation") {  // ģͻʵƽ
+                float f1, f2, f3;
+                ss>>f1>>f2>>f3;
+                if (inInstance) asset.instanceItems.back().instance->translation = {f1, f2, f3};
+                else (asset.modelItems.end() - 1)->model->translation = {f1, f2, f3};
             }
-            else if (token == "Translation") {  // ģƽ
+            else if (token == "Rotation") {  // ʵתXYZĽǶȣȣ
                 float f1, f2, f3;
                 ss>>f1>>f2>>f3;
-                (asset.modelItems.end() - 1)->model->translation = {f1, f2, f3};
+                if (!inInstance) {
+                    lastErrorInfo = "Rotation is only supported for instances.";
+                    successFlag = false;
+                    break;
+                }
+                asset.instanceItems.back().instance->rotation = {f1, f2, f3};
             }
-            else if (token == "Scale") {  // ģ
+            else if (token == "Scale") {  // ģͻʵ
                 float f1, f2, f3;
                 ss>>f1>>f2>>f3;
-                (asset.modelItems.end() - 1)->model->scale = {f1, f2, f3};
+                if (inInstance) asset.instanceItems.back().instance->scale = {f1, f2, f3};
+                else (asset.modelItems.end() - 1)->model->scale = {f1, f2, f3};
+            }
+            else if (inInstance && (token == "Sphere" || token == "Triangle" || token == "Plane")) {
+                lastErrorInfo = "Nodes cannot be added to an instance.";
+                successFlag = false;
+                break;
             }
             else if (token == "Sphere") {  // ڵ
                 NodeItem ni{};
@@ -466,6 +504,7 @@ namespace NRenderer
         // ¼ǰʲ״̬
         size_t beginModel = asset.modelItems.size();
         size_t beginNode = asset.nodeItems.size();
+        size_t beginInstance = asset.instanceItems.size();
         size_t beginMaterial = asset.materialItems.size();
         size_t beginTexture = asset.textureItems.size();
 
@@ -540,6 +579,7 @@ namespace NRenderer
         if (!successFlag) {
             asset.modelItems        .erase(asset.modelItems         .begin() + beginModel,      asset.modelItems.end());
             asset.nodeItems         .erase(asset.nodeItems          .begin() + beginNode,       asset.nodeItems.end());
+            asset.instanceItems     .erase(asset.instanceItems      .begin() + beginInstance,   asset.instanceItems.end());
             asset.materialItems     .erase(asset.materialItems      .begin() + beginMaterial,   asset.materialItems.end());
             asset.textureItems      .erase(asset.textureItems       .begin() + beginTexture,    asset.textureItems.end());
             
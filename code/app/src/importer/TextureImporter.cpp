@@ -14,16 +14,14 @@ namespace NRenderer
     // ֵ: Ƿɹ
     bool TextureImporter::import(Asset& asset, const string& path) {
         ImageLoader imgLoader;
-        auto img = imgLoader.load(path);                // ͼļ
 
-        // 
+        // 8λͼRGBA8棬HDRͼ񰴰뾫ȸ
         SharedTexture spTexture{new Texture()};
-        spTexture->width = img->width;                 // 
-        spTexture->height = img->height;               // ߶
-        spTexture->rgba = (RGBA*)img->data;           // 
+        if (!imgLoader.loadTexture(path, *spTexture)) return false;
+        spTexture->generateMipmaps();                  // ɶ༶Զ
 
         // OpenGL
-        auto id = GlImage::loadImage(spTexture->rgba, {spTexture->width, spTexture->height});
+        auto id = GlImage::loadTexture(*spTexture);
 
         // 
         TextureItem ti;
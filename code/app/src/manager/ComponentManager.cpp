@@ -12,6 +12,7 @@ namespace NRenderer
         : state             (State::IDLING)         // ʼ״̬Ϊ
         , loadedDlls        ()                      // ѼصDLLб
         , activeComponent   ()                      // ǰ
+        , activeInstance    ()                      // ǰʵ
         , lastStartTime     ()                      // ϴִпʼʱ
         , lastEndTime       ()                      // ϴִнʱ
         , t                 ()                      // ִ߳
@@ -43,6 +44,16 @@ namespace NRenderer
     // ״̬Ϊ
     void ComponentManager::finish() {
         state = State::IDLING;
+        activeInstance = nullptr;
+    }
+
+    // ǰеȾǰ
+    // ֻȾֹ֧ͣ
+    void ComponentManager::requestStop() {
+        auto renderComponent = dynamic_pointer_cast<RenderComponent>(activeInstance);
+        if (renderComponent) {
+            renderComponent->requestStop();
+        }
     }
 
     // ȡǰϢ
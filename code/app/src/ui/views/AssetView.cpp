@@ -189,6 +189,12 @@ namespace NRenderer
                 }
                 ImGui::EndMenu();
             }
+            if (ImGui::BeginMenu("导出")) {
+                if (ImGui::MenuItem("场景")) {
+                    manager.assetManager.exportScene();
+                }
+                ImGui::EndMenu();
+            }
             if (ImGui::BeginMenu("重置")) {
                 if (ImGui::MenuItem("重置全部")) {
                     manager.assetManager.clearAll();
@@ -286,6 +292,24 @@ namespace NRenderer
                     }
                 }
 
+                // 模型实例
+                auto& iis = manager.assetManager.asset.instanceItems;
+                for (int i = 0; i < iis.size(); i++) {
+                    auto& ii = iis[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    bool instance_selected = (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_INSTANCE
+                        && uiContext.previewInstance == i);
+                    if (ImGui::Selectable(("##InstanceItemIndex"+to_string(i+1)).c_str(), &instance_selected, ImGuiSelectableFlags_SpanAllColumns)) {
+                        uiContext.previewInstance = i;
+                        uiContext.previewMode = UIContext::PreviewMode::PREVIEW_INSTANCE;
+                    }
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(ii.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted("Instance");
+                }
+
                 ImGui::EndTable();
             }
         }
@@ -307,8 +331,13 @@ namespace NRenderer
                 ImGui::SameLine();
                 ImGui::TextUnformatted(to_string(uiContext.previewModel).c_str());
                 ImGui::Separator();
-                ImGui::DragFloat3(("Translation##ModelSelected"+to_string(uiContext.previewModel)).c_str(), &mi.model->translation.x, 0.5, 0, 0);
-                ImGui::DragFloat3(("Scale##ModelSelected"+to_string(uiContext.previewModel)).c_str(), &mi.model->scale.x, 0.05, 0, 0);
+                bool transformChanged = false;
+                transformChanged |= ImGui::DragFloat3(("Translation##ModelSelected"+to_string(uiContext.previewModel)).c_str(), &mi.model->translation.x, 0.5, 0, 0);
+                transformChanged |= ImGui::DragFloat3(("Scale##ModelSelected"+to_string(uiContext.previewModel)).c_str(), &mi.model->scale.x, 0.05, 0, 0);
+                transformChanged |= ImGui::Checkbox(("Visible##ModelSelected"+to_string(uiContext.previewModel)).c_str(), &mi.model->visible);
+                if (transformChanged) {
+                    asset.markGeometryDirty(&mi);
+                }
 
             }
             else if (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_NODE
@@ -323,7 +352,8 @@ namespace NRenderer
                 ImGui::TextUnformatted(to_string(uiContext.previewNode).c_str());
                 auto& mtls = asset.materialItems;
                 auto& n = *ni.node;
-                auto selectMaterial = [&mtls](Handle& mtlHandle) -> void {
+                bool materialChanged = false;
+                auto selectMaterial = [&mtls, &materialChanged](Handle& mtlHandle) -> void {
                     bool mtlValid = mtlHandle.valid() && mtlHandle.index() < mtls.size();
                     string comboPreview = mtlValid ? mtls[mtlHandle.index()].name : "";
                     if (ImGui::BeginCombo("Material##SphereNode", comboPreview.c_str())) {
@@ -331,6 +361,7 @@ namespace NRenderer
                             bool selected = i == mtlHandle.index();
                             auto& mtl = mtls[i];
                             if (ImGui::Selectable((to_string(i+1)+". "+mtl.name+"##NodeSettings").c_str(), &selected)) {
+                                materialChanged |= mtlHandle.index() != i;
                                 mtlHandle.setIndex(i);
                             }
                         }
@@ -355,25 +386,56 @@ namespace NRenderer
                     selectMaterial(mtlHandle); 
                 }
                 else if (n.type == Node::Type::MESH) {
-                    auto& m = *asset.meshes[n.entity];
-                    auto& mtlHandle = m.material;
-                    selectMaterial(mtlHandle); 
+                    // 网格与已构建的场景共享，修改时先复制一份（写时复制）
+                    auto& spMesh = asset.meshes[n.entity];
+                    Handle mtlHandle = spMesh->material;
+                    selectMaterial(mtlHandle);
+                    if (mtlHandle.getValue() != spMesh->material.getValue()) {
+                        auto mesh = make_shared<Mesh>(*spMesh);
+                        mesh->material = mtlHandle;
+                        spMesh = mesh;
+                    }
                 }
             
                 if (change) {
                     asset.updateNodeGlDrawData(ni);
                 }
+                if (materialChanged) {
+                    asset.markMaterialDirty(&ni);
+                }
+            }
+            else if (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_INSTANCE
+                && uiContext.previewInstance >= 0 && uiContext.previewInstance < asset.instanceItems.size()) {
+                auto& ii = asset.instanceItems[uiContext.previewInstance];
+                auto& inst = *ii.instance;
+                ImGui::TextUnformatted("Settings");
+                ImGui::TextUnformatted("Name: ");
+                ImGui::SameLine();
+                ImGui::TextUnformatted(ii.name.c_str());
+                ImGui::TextUnformatted("Model: ");
+                ImGui::SameLine();
+                ImGui::TextUnformatted(inst.model < mis.size() ? mis[inst.model].name.c_str() : "--");
+                ImGui::Separator();
+                string id = "##InstanceSelected" + to_string(uiContext.previewInstance);
+                bool transformChanged = false;
+                transformChanged |= ImGui::DragFloat3(("Translation"+id).c_str(), &inst.translation.x, 0.5, 0, 0);
+                transformChanged |= ImGui::DragFloat3(("Rotation"+id).c_str(), &inst.rotation.x, 1, 0, 0);
+                transformChanged |= ImGui::DragFloat3(("Scale"+id).c_str(), &inst.scale.x, 0.05, 0, 0);
+                if (transformChanged) {
+                    asset.markGeometryDirty(&ii);
+                }
             }
         }
         ImGui::EndChild();
         ImGui::Columns(1);
     }
 
-    void AssetView::materialPropEditor(SharedMaterial spMaterial) {
+    bool AssetView::materialPropEditor(SharedMaterial spMaterial) {
         using P = Property;
         using T = Property::Type;
         using W = Property::Wrapper;
         #define SET(__T__, __V__) p.valueWrapper = W::__T__##Type{__V__}
+        bool changed = false;
         int i = 0;
         for (auto& p : spMaterial->properties) {
             ImGui::PushID(i);
@@ -382,6 +444,7 @@ namespace NRenderer
             ImGui::PushStyleColor(ImGuiCol_ButtonActive, (ImVec4)ImColor::HSV(0, 0.8f, 0.8f));
             if (ImGui::Button(" - ")) {
                 spMaterial->removeProperty(p.key);
+                changed = true;
             }
             ImGui::PopStyleColor(3);
             ImGui::PopID();
@@ -392,42 +455,42 @@ namespace NRenderer
             case T::INT:
             {
                 auto v = get<0>(p.valueWrapper).value;
-                ImGui::InputInt((p.key+"##PEInt"+to_string(i)).c_str(), &v, 0, 0);
+                changed |= ImGui::InputInt((p.key+"##PEInt"+to_string(i)).c_str(), &v, 0, 0);
                 SET(Int, v);
                 break;
             }
             case T::FLOAT:
             {
                 auto v = get<1>(p.valueWrapper).value;
-                ImGui::InputFloat((p.key+"##PEFloat"+to_string(i)).c_str(), &v, 0, 0);
+                changed |= ImGui::InputFloat((p.key+"##PEFloat"+to_string(i)).c_str(), &v, 0, 0);
                 SET(Float, v);
                 break;
             }
             case T::RGB:
             {
                 auto v = get<2>(p.valueWrapper).value;
-                ImGui::ColorEdit3((p.key+"##PERGB"+to_string(i)).c_str(), &v[0], ImGuiColorEditFlags_Float);
+                changed |= ImGui::ColorEdit3((p.key+"##PERGB"+to_string(i)).c_str(), &v[0], ImGuiColorEditFlags_Float);
                 SET(RGB, v);
                 break;
             }
             case T::RGBA:
             {
                 auto v = get<3>(p.valueWrapper).value;
-                ImGui::ColorEdit4((p.key+"##PERGBA"+to_string(i)).c_str(), &v[0], ImGuiColorEditFlags_Float | ImGuiColorEditFlags_AlphaPreview);
+                changed |= ImGui::ColorEdit4((p.key+"##PERGBA"+to_string(i)).c_str(), &v[0], ImGuiColorEditFlags_Float | ImGuiColorEditFlags_AlphaPreview);
                 SET(RGBA, v);
                 break;
             }
             case T::VEC3:
             {
                 auto v = get<4>(p.valueWrapper).value;
-                ImGui::InputFloat3((p.key+"##PEVec3"+to_string(i)).c_str(), &v[0]);
+                changed |= ImGui::InputFloat3((p.key+"##PEVec3"+to_string(i)).c_str(), &v[0]);
                 SET(Vec3, v);
                 break;
             }
             case T::VEC4:
             {
                 auto v = get<5>(p.valueWrapper).value;
-                ImGui::InputFloat4((p.key+"##PEVec4"+to_string(i)).c_str(), &v[0]);
+                changed |= ImGui::InputFloat4((p.key+"##PEVec4"+to_string(i)).c_str(), &v[0]);
                 SET(Vec4, v);
                 break;
             }
@@ -439,6 +502,7 @@ namespace NRenderer
                         bool selected = v.valid() ? (i == v.index()) : false;
                         if (ImGui::Selectable(manager.assetManager.asset.textureItems[i].name.c_str(), &selected)) {
                             v.setIndex(i);
+                            changed = true;
                         }
                     }
                     ImGui::EndCombo();
@@ -452,6 +516,7 @@ namespace NRenderer
             i++;
         };
         #undef SET
+        return changed;
     }
 
     void AssetView::materialTab() {
@@ -532,6 +597,7 @@ namespace NRenderer
             ImGui::EndChild();
             if (ImGui::Button("Add##Add_Material")) {
                 manager.assetManager.asset.materialItems.push_back(tempMaterialItem);
+                manager.assetManager.asset.markMaterialDirty(&manager.assetManager.asset.materialItems.back());
                 tempMaterialItem = MaterialItem{};
                 tempMaterialItem.material = SharedMaterial{new Material{}};
                 ImGui::CloseCurrentPopup();
@@ -586,7 +652,7 @@ namespace NRenderer
                 if (ImGui::InputText("Name##MTLSelected", buf, 64)) {
                     mtlItem.name = string(buf);
                 }
-                ImGui::InputInt("Type", (int*)&mtl.type, 0);
+                bool materialChanged = ImGui::InputInt("Type", (int*)&mtl.type, 0);
                 ImGui::SameLine();
                 makeHelper((
                     string("Default Material Templates:") + 
@@ -613,6 +679,7 @@ namespace NRenderer
                     tempPropEditor();
                     if (ImGui::Button("Confirm##Property_Editor")) {
                         if (mtl.registerProperty(tempProp)) {
+                            materialChanged = true;
                             resetTempProp();
                             ImGui::CloseCurrentPopup();
                         }
@@ -631,9 +698,12 @@ namespace NRenderer
                 ImGui::Separator();
                 ImGui::BeginChild("Mtl Props");
                 {
-                    materialPropEditor(mtlItem.material);
+                    materialChanged |= materialPropEditor(mtlItem.material);
                 }
                 ImGui::EndChild();
+                if (materialChanged) {
+                    manager.assetManager.asset.markMaterialDirty(&mtlItem);
+                }
             }
         }
         ImGui::EndChild();
@@ -728,39 +798,44 @@ namespace NRenderer
             auto& l = *li.light;
             ImGui::TextUnformatted("Settings:");
             using T = Light::Type;
+            bool lightChanged = false;
             if (l.type == T::POINT) {
                 auto& p = *manager.assetManager.asset.pointLights[l.entity];
-                ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &p.intensity[0], 0.01);
-                ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &p.position[0], 1);
+                lightChanged |= ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &p.intensity[0], 0.01);
+                lightChanged |= ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &p.position[0], 1);
             }
             else if (l.type == T::AREA) {
                 bool dirty = false;
                 auto& a = *manager.assetManager.asset.areaLights[l.entity];
-                ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &a.radiance[0], 0.01);
-                ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &a.position[0], 1);
+                lightChanged |= ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &a.radiance[0], 0.01);
+                lightChanged |= ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &a.position[0], 1);
                 dirty |= ImGui::DragFloat3(("U##LightSelected"+to_string(currLightIndex)).c_str(), &a.u[0], 1);
                 dirty |= ImGui::DragFloat3(("V##LightSelected"+to_string(currLightIndex)).c_str(), &a.v[0], 1);
                 if (dirty) {
                     manager.assetManager.asset.updateLightGlDrawData(li);
+                    lightChanged = true;
                 }
             }
             else if (l.type == T::DIRECTIONAL) {
                 auto& d = *manager.assetManager.asset.directionalLights[l.entity];
-                ImGui::DragFloat3(("Irradiance##LightSelected"+to_string(currLightIndex)).c_str(), &d.irradiance[0], 0.01);
-                ImGui::DragFloat3(("Direction##LightSelected"+to_string(currLightIndex)).c_str(), &d.direction[0], 0.1);
+                lightChanged |= ImGui::DragFloat3(("Irradiance##LightSelected"+to_string(currLightIndex)).c_str(), &d.irradiance[0], 0.01);
+                lightChanged |= ImGui::DragFloat3(("Direction##LightSelected"+to_string(currLightIndex)).c_str(), &d.direction[0], 0.1);
             }
             else if (l.type == T::SPOT) {
                 auto& s = *manager.assetManager.asset.spotLights[l.entity];
-                ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &s.intensity[0], 0.01);
-                ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &s.position[0], 1);
-                ImGui::DragFloat3(("Direction##LightSelected"+to_string(currLightIndex)).c_str(), &s.direction[0], 0.1);
+                lightChanged |= ImGui::DragFloat3(("Intensity##LightSelected"+to_string(currLightIndex)).c_str(), &s.intensity[0], 0.01);
+                lightChanged |= ImGui::DragFloat3(("Position##LightSelected"+to_string(currLightIndex)).c_str(), &s.position[0], 1);
+                lightChanged |= ImGui::DragFloat3(("Direction##LightSelected"+to_string(currLightIndex)).c_str(), &s.direction[0], 0.1);
                 float hotSpot = s.hotSpot * 180.f / 3.1415926;
                 float fallout = s.fallout * 180.f / 3.1415926;
-                ImGui::DragFloat(("HotSpot##LightSelected"+to_string(currLightIndex)).c_str(), &hotSpot, 0.1, 0, 180);
-                ImGui::DragFloat(("Fallout##LightSelected"+to_string(currLightIndex)).c_str(), &fallout, 0.1, 0, 180);
+                lightChanged |= ImGui::DragFloat(("HotSpot##LightSelected"+to_string(currLightIndex)).c_str(), &hotSpot, 0.1, 0, 180);
+                lightChanged |= ImGui::DragFloat(("Fallout##LightSelected"+to_string(currLightIndex)).c_str(), &fallout, 0.1, 0, 180);
                 s.hotSpot = hotSpot * 3.1415926 / 180.f;
                 s.fallout = fallout * 3.1415926 / 180.f;
             }
+            if (lightChanged) {
+                manager.assetManager.asset.markLightDirty(&li);
+            }
         }
         uiContext.previewLight = currLightIndex;
         ImGui::EndChild();
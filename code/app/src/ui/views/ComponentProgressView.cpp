@@ -36,6 +36,10 @@ namespace NRenderer
                 // 
                 uiContext.state = UIContext::State::HOVER_COMPONENT_PROGRESS;
                 ImGui::TextUnformatted(("ִ: " + activeComponentInfo.id).c_str());
+                // ȾǰʽȾᱣɵĲ
+                if (ImGui::Button("Stop##ComponentProgress")) {
+                    componentManager.requestStop();
+                }
             }
             else if (componentManager.getState() == ComponentManager::State::READY) {
                 // ׼
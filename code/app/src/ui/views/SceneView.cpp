@@ -57,6 +57,34 @@ namespace NRenderer
         ImGui::InputScalar("Height", ImGuiDataType_U32, &rs.height, &intStep, NULL, "%u");          // Ⱦ߶
         ImGui::InputScalar("Depth", ImGuiDataType_U32, &rs.depth, &intStep, NULL, "%u");            // ׷
         ImGui::InputScalar("Sample Nums", ImGuiDataType_U32, &rs.samplesPerPixel, &intStep, NULL, "%u");  // 
+        ImGui::Checkbox("Progressive", &rs.progressive);                                             // ʽȾ
+        if (rs.progressive) {
+            ImGui::InputScalar("Samples Per Pass", ImGuiDataType_U32, &rs.samplesPerPass, &intStep, NULL, "%u");  // ÿֲ
+        }
+        ImGui::InputScalar("Threads (0 = auto)", ImGuiDataType_U32, &rs.threads, &intStep, NULL, "%u");  // Ⱦ߳
+
+        // ѡ
+        const string samplerStr[3] = {"Random", "Halton", "Sobol"};
+        const RenderSettings::SamplerType samplerTypes[3] = {
+            RenderSettings::SamplerType::RANDOM, RenderSettings::SamplerType::HALTON, RenderSettings::SamplerType::SOBOL
+        };
+        int currSampler = int(rs.sampler);
+        if (ImGui::BeginCombo("Sampler##RenderSettings", samplerStr[currSampler].c_str())) {
+            for (int i=0; i<3; i++) {
+                bool selected = currSampler == i;
+                if (ImGui::Selectable((samplerStr[i]+"##SamplerTypeItem").c_str(), &selected)) {
+                    rs.sampler = samplerTypes[i];
+                    currSampler = i;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::InputScalar("Seed", ImGuiDataType_U32, &rs.seed, &intStep, NULL, "%u");              // 
+        ImGui::Checkbox("Adaptive Sampling", &rs.adaptiveSampling);                                  // Ӧ
+        if (rs.adaptiveSampling) {
+            ImGui::DragFloat("Error Threshold", &rs.adaptiveThreshold, 0.001f, 0.001f, 1.f, "%.3f");  // ֵ
+        }
+        ImGui::Checkbox("Denoise", &rs.denoise);                                                     // 
     }
 
     // ý
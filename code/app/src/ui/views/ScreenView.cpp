@@ -7,8 +7,49 @@
 #include "glm/ext/matrix_transform.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <vector>
+#include <algorithm>
+
 namespace NRenderer
 {
+    // AOVͨתΪʾɫ
+    // ӳ䵽[0,1]ȡ뷽ֵһ±갴ϣɫ
+    static vector<RGBA> visualizeChannel(const Framebuffer& fb, Framebuffer::Channel channel) {
+        using Channel = Framebuffer::Channel;
+        unsigned int size = fb.getWidth()*fb.getHeight();
+        vector<RGBA> pixels(size);
+        if (Framebuffer::channelComponents(channel) == 3) {
+            for (unsigned int i=0; i<size; i++) {
+                Vec3 v = fb.getVec3(channel, i);
+                if (channel == Channel::NORMAL) v = v*0.5f + 0.5f;
+                pixels[i] = {clamp(v), 1};
+            }
+        }
+        else if (channel == Channel::MATERIAL_ID || channel == Channel::PRIMITIVE_ID) {
+            for (unsigned int i=0; i<size; i++) {
+                float id = fb.get(channel, i);
+                if (id < 0) {
+                    pixels[i] = {0, 0, 0, 1};
+                    continue;
+                }
+                unsigned int h = unsigned(id)*2654435761u;
+                pixels[i] = {float(h & 0xff)/255.f, float((h >> 8) & 0xff)/255.f, float((h >> 16) & 0xff)/255.f, 1};
+            }
+        }
+        else {
+            float maxValue = 0;
+            for (unsigned int i=0; i<size; i++) {
+                maxValue = std::max(maxValue, fb.get(channel, i));
+            }
+            for (unsigned int i=0; i<size; i++) {
+                float v = maxValue > 0 ? fb.get(channel, i) / maxValue : 0.f;
+                if (channel == Channel::VARIANCE) v = sqrt(v);  // ȴʾ׼
+                pixels[i] = {v, v, v, 1};
+            }
+        }
+        return pixels;
+    }
+
     // ɫԴ붨
 #pragma region __SHADER_SOURCE__
     // ڵ㶥ɫ
@@ -63,10 +104,13 @@ namespace NRenderer
     ScreenView::ScreenView(const Vec2& position, const Vec2& size, UIContext& uiContext, Manager& manager)
         : View                      (position, size, uiContext, manager)  // û๹캯
         , renderResult              (0)                                   // ȾID
+        , resultSize                (0, 0)                                // Ⱦߴ
         , previewResult             (0)                                   // ԤID
         , viewType                  (ViewType::PREVIEW)                   // ĬΪԤģʽ
         , shrinkLevel               (0)                                   // Ĭż
         , previewCoordinateType     (CoordinateType::LEFT_HANDED)        // Ĭϵ
+        , resultChannel             (Framebuffer::Channel::BEAUTY)        // Ĭʾɫ
+        , resultChannelChanged      (false)
         , nodeShader                (nodeVShaderSource, nodeFShaderSource)    // ʼڵɫ
         , lightShader               (lightVShaderSource, lightFShaderSource)  // ʼԴɫ
     {
@@ -156,6 +200,35 @@ namespace NRenderer
             ImGui::EndCombo();
         }
 
+        // ͨѡ뱣
+        if (viewType == ViewType::RESULT) {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120);
+            if (ImGui::BeginCombo("##ResultChannel", Framebuffer::channelName(resultChannel))) {
+                for (unsigned int i=0; i < Framebuffer::channelCount; i++) {
+                    auto channel = Framebuffer::Channel(i);
+                    if (channel != Framebuffer::Channel::BEAUTY && !getServer().screen.hasChannel(channel)) continue;
+                    bool selected = channel == resultChannel;
+                    if (ImGui::Selectable(Framebuffer::channelName(channel), &selected)) {
+                        resultChannel = channel;
+                        resultChannelChanged = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Save", {60, 22})) {
+                string path = string("result_") + Framebuffer::channelName(resultChannel) + ".pfm";
+                std::replace(path.begin(), path.end(), ' ', '_');
+                if (getServer().screen.saveChannel(resultChannel, path)) {
+                    getServer().logger.success("Saved " + path);
+                }
+                else {
+                    getServer().logger.error("Failed to save " + path);
+                }
+            }
+        }
+
         // ϵлť
         if (viewType == ViewType::PREVIEW) {
             ImGui::SameLine();
@@ -200,14 +273,25 @@ namespace NRenderer
 
     // Ⱦ
     void ScreenView::result() {
-        Vec2 rs = {getServer().screen.getWidth(), getServer().screen.getHeight()};
         // µȾ
-        if (getServer().screen.isUpdated()) {
+        if (getServer().screen.isUpdated() || resultChannelChanged || renderResult == 0) {
             if (renderResult != 0) GlImage::deleteImage(renderResult);
-            auto pixels = getServer().screen.getPixels();
-            renderResult = GlImage::loadImage(pixels, rs);  // µȾ
+            // ʽȾʱȾ̻߳᲻ϸĻֻʹͬһζȡõߴ
+            unsigned int width, height;
+            auto pixels = getServer().screen.getPixels(width, height);
+            resultSize = {width, height};
+            auto fb = resultChannel == Framebuffer::Channel::BEAUTY ? Framebuffer{} : getServer().screen.getFramebuffer();
+            // ѡAOVͨҳߴһʱʾͨʾɫ
+            if (fb.has(resultChannel) && fb.getWidth() == width && fb.getHeight() == height) {
+                auto channelPixels = visualizeChannel(fb, resultChannel);
+                renderResult = GlImage::loadImage(channelPixels.data(), resultSize);
+            }
+            else {
+                renderResult = GlImage::loadImage(pixels.data(), resultSize);  // µȾ
+            }
+            resultChannelChanged = false;
         }
-        rs *= getShrinkNum();  // Ӧ
+        Vec2 rs = resultSize*getShrinkNum();  // Ӧ
         this->align(rs);       // ͼ
         ImGui::Image((void*)(intptr_t)renderResult, { rs.x, rs.y }, { 0, 0 }, { 1, 1 });
     }
@@ -289,6 +373,8 @@ namespace NRenderer
         auto& asset = manager.assetManager.asset;
         for (int i=0; i<asset.nodeItems.size(); i++) {
             auto& ni = asset.nodeItems[i];
+            // ֻΪʵģģͲƣѡʱԸʾ
+            if (!asset.modelItems[ni.node->model].model->visible) continue;
             if (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_MODEL) {
                 if (uiContext.previewModel != ni.node->model) {
                     nodeShader.setVec4("drawColor", commonColor);
@@ -306,6 +392,18 @@ namespace NRenderer
                 previewNode(ni);
             }
         }
+        // ģʵģ͸ڵĻ
+        for (int i=0; i<asset.instanceItems.size(); i++) {
+            auto& inst = *asset.instanceItems[i].instance;
+            if (inst.model >= asset.modelItems.size()) continue;
+            bool selected = (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_INSTANCE && uiContext.previewInstance == i)
+                || (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_MODEL && uiContext.previewModel == inst.model);
+            nodeShader.setVec4("drawColor", selected ? selectedColor : commonColor);
+            auto transform = inst.matrix();
+            for (auto& nIdx : asset.modelItems[inst.model].model->nodes) {
+                previewNode(asset.nodeItems[nIdx], transform, inst.scale);
+            }
+        }
         if (uiContext.previewMode == UIContext::PreviewMode::PREVIEW_MODEL) {
             if (uiContext.previewModel != -1 && uiContext.previewModel < asset.modelItems.size()) {
                 auto& m = *asset.modelItems[uiContext.previewModel].model;
@@ -353,32 +451,37 @@ namespace NRenderer
     }
 
     void ScreenView::previewNode(const NodeItem& n) {
+        auto& asset = manager.assetManager.asset;
+        auto& model = *asset.modelItems[n.node->model].model;
+        Mat4x4 transform{1};
+        transform = glm::translate(transform, model.translation);
+        transform = glm::scale(transform, model.scale);
+        previewNode(n, transform, model.scale);
+    }
+
+    void ScreenView::previewNode(const NodeItem& n, const Mat4x4& transform, const Vec3& scale) {
         auto& camera = manager.renderSettingsManager.camera;
         auto& asset = manager.assetManager.asset;
         glBindVertexArray(n.glVAO);
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         Mat4x4 modelMat{1};
-        auto& model = *asset.modelItems[n.node->model].model;
         if (n.node->type == Node::Type::TRIANGLE) {
-            modelMat = glm::translate(modelMat, model.translation);
-            modelMat = glm::scale(modelMat, model.scale);
-            nodeShader.setMat4x4("model", modelMat);
+            nodeShader.setMat4x4("model", transform);
             glDrawArrays(GL_TRIANGLES, 0, 3);
         }
         else if (n.node->type == Node::Type::PLANE) {
-            modelMat = glm::translate(modelMat, model.translation);
-            modelMat = glm::scale(modelMat, model.scale);
-            nodeShader.setMat4x4("model", modelMat);
+            nodeShader.setMat4x4("model", transform);
             glDrawArrays(GL_LINE_LOOP, 0, 4);
         }
         else if (n.node->type == Node::Type::SPHERE) {
+            // 廭ɳԲֻȡ任
             const Vec3 norm{0, 0, -1};
-            Vec3 pos = asset.spheres[n.node->entity]->position + model.translation;
+            Vec3 pos = Vec3(transform*Vec4(asset.spheres[n.node->entity]->position, 1));
             Vec3 dir = camera.position - camera.lookAt;
             dir = -glm::normalize(dir);
             float cos_theta = glm::dot(dir, norm);
             modelMat = glm::translate(modelMat, pos);
-            modelMat = glm::scale(modelMat, model.scale);
+            modelMat = glm::scale(modelMat, scale);
             if (dir != norm && dir != -norm) {
                 Vec3 axis = glm::cross(dir, norm);
                 float angle = -acos(cos_theta);
@@ -388,9 +491,7 @@ namespace NRenderer
             glDrawArrays(GL_LINE_STRIP, 0, n.externalDrawData->positions.size());
         }
         else if (n.node->type == Node::Type::MESH) {
-            modelMat = glm::translate(modelMat, model.translation);
-            modelMat = glm::scale(modelMat, model.scale);
-            nodeShader.setMat4x4("model", modelMat);
+            nodeShader.setMat4x4("model", transform);
             auto& m = *asset.meshes[n.node->entity];
             glDrawElements(GL_TRIANGLES, m.positionIndices.size(), GL_UNSIGNED_INT, 0);
         }
@@ -0,0 +1,78 @@
+#include "utilities/AsyncTextureLoader.hpp"
+#include "utilities/ImageLoader.hpp"
+
+#include <filesystem>
+
+// 첽ʵļ
+
+namespace NRenderer
+{
+    AsyncTextureLoader::AsyncTextureLoader(unsigned int threads)
+        : stopping          (false)
+        , maxWorkers        (threads == 0 ? max(thread::hardware_concurrency(), 1u) : threads)
+    {}
+
+    AsyncTextureLoader::~AsyncTextureLoader() {
+        {
+            lock_guard<mutex> guard{lock};
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    shared_future<SharedTexture> AsyncTextureLoader::request(const string& path) {
+        // 淶ʧܣļڣʱԭ·ȥأʱٱʧ
+        error_code ec;
+        auto canonical = filesystem::weakly_canonical(filesystem::path(path), ec);
+        string key = ec ? path : canonical.string();
+        return enqueue(key, Task{path, nullptr, 0, {}});
+    }
+
+    shared_future<SharedTexture> AsyncTextureLoader::request(const string& key, const char* data, size_t size) {
+        return enqueue(key, Task{key, data, size, {}});
+    }
+
+    shared_future<SharedTexture> AsyncTextureLoader::enqueue(const string& key, Task task) {
+        lock_guard<mutex> guard{lock};
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+
+        auto future = task.result.get_future().share();
+        cache.emplace(key, future);
+        tasks.push_back(move(task));
+        // ÿһֱ̣߳ﵽ߳
+        if (workers.size() < maxWorkers) {
+            workers.emplace_back(&AsyncTextureLoader::work, this);
+        }
+        cv.notify_one();
+        return future;
+    }
+
+    void AsyncTextureLoader::work() {
+        ImageLoader imageLoader{};
+        while (true) {
+            Task task;
+            {
+                unique_lock<mutex> guard{lock};
+                cv.wait(guard, [this]() { return stopping || !tasks.empty(); });
+                if (stopping) return;
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            auto texture = make_shared<Texture>();
+            // 8λͼRGBA8棨ÿ4ֽڣHDRͼ񰴰뾫ȸ
+            bool loaded = task.data
+                ? imageLoader.loadTexture(reinterpret_cast<const unsigned char*>(task.data), task.size, *texture)
+                : imageLoader.loadTexture(task.path, *texture);
+            if (loaded) {
+                // ʱɶ༶ԶȾʱ׶ĸǷΧѡ񼶱
+                texture->generateMipmaps();
+                task.result.set_value(texture);
+            }
+            else {
+                task.result.set_value(nullptr);
+            }
+        }
+    }
+} // namespace NRenderer
\ No newline at end of file
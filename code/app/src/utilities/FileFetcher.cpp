@@ -50,4 +50,29 @@ namespace NRenderer
             return nullopt;                          // ûȡnullopt
         }
     }
+
+    // 򿪱ļԻ
+    // filter: ļַ
+    // defaultExt: Ĭչ
+    // ֵ: ļ·ȡ򷵻nullopt
+    optional<string> FileFetcher::fetchSave(const char* filter, const char* defaultExt) const
+    {
+        OPENFILENAME ofn;
+        TCHAR szFile[260];
+        ZeroMemory(&ofn, sizeof(ofn));
+        ofn.lStructSize = sizeof(ofn);
+        ofn.hwndOwner = GetActiveWindow();
+        ofn.lpstrFile = szFile;
+        ofn.lpstrFile[0] = '\0';
+        ofn.nMaxFile = sizeof(szFile);
+        ofn.lpstrFilter = (filter);
+        ofn.nFilterIndex = 1;
+        ofn.lpstrDefExt = defaultExt;
+        ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT;  // ·ڣļǰȷ
+
+        if (GetSaveFileName(&ofn) == TRUE) {
+            return string{(char *)ofn.lpstrFile};
+        }
+        return nullopt;
+    }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "utilities/ImageLoader.hpp"
 
+#include <climits>
+
 // ͼʵļ
 // ʹstb_imageͼļ
 
@@ -34,4 +36,49 @@ namespace NRenderer
 
 		return image;
 	}
+
+	// ͼļΪոʽ
+	// file: ͼļ·
+	// texture: 
+	// ֵ: Ƿسɹ
+	bool ImageLoader::loadTexture(const string& file, Texture& texture) {
+		int width, height, channel;
+		if (stbi_is_hdr(file.c_str())) {
+			float* data = stbi_loadf(file.c_str(), &width, &height, &channel, 4);
+			if (data == nullptr) return false;
+			texture.setRGBA16F(width, height, data);
+			stbi_image_free(data);
+		}
+		else {
+			auto data = stbi_load(file.c_str(), &width, &height, &channel, 4);
+			if (data == nullptr) return false;
+			texture.setRGBA8(width, height, data);
+			stbi_image_free(data);
+		}
+		return true;
+	}
+
+	// ڴеıͼ
+	// data: ͼ
+	// size: ֽ
+	// texture: 
+	// ֵ: Ƿسɹ
+	bool ImageLoader::loadTexture(const unsigned char* data, size_t size, Texture& texture) {
+		if (size > size_t(INT_MAX)) return false;
+		int width, height, channel;
+		int len = int(size);
+		if (stbi_is_hdr_from_memory(data, len)) {
+			float* pixels = stbi_loadf_from_memory(data, len, &width, &height, &channel, 4);
+			if (pixels == nullptr) return false;
+			texture.setRGBA16F(width, height, pixels);
+			stbi_image_free(pixels);
+		}
+		else {
+			auto pixels = stbi_load_from_memory(data, len, &width, &height, &channel, 4);
+			if (pixels == nullptr) return false;
+			texture.setRGBA8(width, height, pixels);
+			stbi_image_free(pixels);
+		}
+		return true;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "utilities/Json.hpp"
+
+#include <charconv>
+#include <cstdint>
+
+// JSONʵļ
+// ݹ½ַUTF-8
+
+namespace NRenderer
+{
+    // ݹ½
+    class JsonParser
+    {
+    private:
+        const char* p;
+        const char* end;
+        string error;
+        int depth;
+
+        // Ƕײޣֹļľջռ
+        static constexpr int maxDepth = 256;
+
+        void skipSpace() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+        }
+
+        bool fail(const string& message) {
+            if (error.empty()) error = message;
+            return false;
+        }
+
+        bool expect(const char* word) {
+            for (; *word; word++, p++) {
+                if (p >= end || *p != *word) return fail("Invalid JSON literal.");
+            }
+            return true;
+        }
+
+        // 㰴UTF-8׷ӵַ
+        static void appendUtf8(string& s, uint32_t c) {
+            if (c < 0x80) {
+                s += char(c);
+            }
+            else if (c < 0x800) {
+                s += char(0xc0 | (c >> 6));
+                s += char(0x80 | (c & 0x3f));
+            }
+            else if (c < 0x10000) {
+                s += char(0xe0 | (c >> 12));
+                s += char(0x80 | ((c >> 6) & 0x3f));
+                s += char(0x80 | (c & 0x3f));
+            }
+            else {
+                s += char(0xf0 | (c >> 18));
+                s += char(0x80 | ((c >> 12) & 0x3f));
+                s += char(0x80 | ((c >> 6) & 0x3f));
+                s += char(0x80 | (c & 0x3f));
+            }
+        }
+
+        bool parseHex4(uint32_t& value) {
+            if (end - p < 4) return fail("Invalid JSON escape.");
+            value = 0;
+            for (int i = 0; i < 4; i++, p++) {
+                char c = *p;
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= uint32_t(c - '0');
+                else if (c >= 'a' && c <= 'f') value |= uint32_t(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') value |= uint32_t(c - 'A' + 10);
+                else return fail("Invalid JSON escape.");
+            }
+            return true;
+        }
+
+        bool parseString(string& s) {
+            p++;  // '"'
+            while (p < end && *p != '"') {
+                if (*p != '\\') {
+                    s += *p++;
+                    continue;
+                }
+                if (++p >= end) break;
+                char c = *p++;
+                switch (c) {
+                    case '"': s += '"'; break;
+                    case '\\': s += '\\'; break;
+                    case '/': s += '/'; break;
+                    case 'b': s += '\b'; break;
+                    case 'f': s += '\f'; break;
+                    case 'n': s += '\n'; break;
+                    case 'r': s += '\r'; break;
+                    case 't': s += '\t'; break;
+                    case 'u': {
+                        uint32_t code;
+                        if (!parseHex4(code)) return false;
+                        // 
+                        if (code >= 0xd800 && code < 0xdc00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                            p += 2;
+                            uint32_t low;
+                            if (!parseHex4(low)) return false;
+                            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                        }
+                        appendUtf8(s, code);
+                        break;
+                    }
+                    default:
+                        return fail("Invalid JSON escape.");
+                }
+            }
+            if (p >= end) return fail("Unterminated JSON string.");
+            p++;  // '"'
+            return true;
+        }
+
+        bool parseNumber(double& value) {
+            const char* begin = p;
+            if (p < end && *p == '-') p++;
+            while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-')) p++;
+            auto [next, ec] = from_chars(begin, p, value);
+            if (ec != errc() || next != p) return fail("Invalid JSON number.");
+            return true;
+        }
+
+        bool parseValue(JsonValue& v) {
+            skipSpace();
+            if (p >= end) return fail("Unexpected end of JSON.");
+            char c = *p;
+            if (c == '{' || c == '[') {
+                if (++depth > maxDepth) return fail("JSON nesting is too deep.");
+                bool ok = c == '{' ? parseObject(v) : parseArray(v);
+                depth--;
+                return ok;
+            }
+            if (c == '"') {
+                v.type = JsonValue::Type::STRING;
+                return parseString(v.str);
+            }
+            if (c == 't') {
+                v.type = JsonValue::Type::BOOLEAN;
+                v.boolean = true;
+                return expect("true");
+            }
+            if (c == 'f') {
+                v.type = JsonValue::Type::BOOLEAN;
+                v.boolean = false;
+                return expect("false");
+            }
+            if (c == 'n') {
+                v.type = JsonValue::Type::NUL;
+                return expect("null");
+            }
+            v.type = JsonValue::Type::NUMBER;
+            return parseNumber(v.number);
+        }
+
+        bool parseArray(JsonValue& v) {
+            v.type = JsonValue::Type::ARRAY;
+            p++;  // '['
+            skipSpace();
+            if (p < end && *p == ']') {
+                p++;
+                return true;
+            }
+            while (true) {
+                v.elements.emplace_back();
+                if (!parseValue(v.elements.back())) return false;
+                skipSpace();
+                if (p < end && *p == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < end && *p == ']') {
+                    p++;
+                    return true;
+                }
+                return fail("Expected ',' or ']' in JSON array.");
+            }
+        }
+
+        bool parseObject(JsonValue& v) {
+            v.type = JsonValue::Type::OBJECT;
+            p++;  // '{'
+            skipSpace();
+            if (p < end && *p == '}') {
+                p++;
+                return true;
+            }
+            while (true) {
+                skipSpace();
+                if (p >= end || *p != '"') return fail("Expected member name in JSON object.");
+                v.members.emplace_back();
+                auto& member = v.members.back();
+                if (!parseString(member.first)) return false;
+                skipSpace();
+                if (p >= end || *p != ':') return fail("Expected ':' in JSON object.");
+                p++;
+                if (!parseValue(member.second)) return false;
+                skipSpace();
+                if (p < end && *p == ',') {
+                    p++;
+                    continue;
+                }
+                if (p < end && *p == '}') {
+                    p++;
+                    return true;
+                }
+                return fail("Expected ',' or '}' in JSON object.");
+            }
+        }
+
+    public:
+        JsonParser(string_view text)
+            : p         (text.data())
+            , end       (text.data() + text.size())
+            , depth     (0)
+        {}
+
+        optional<JsonValue> parse(string& errorInfo) {
+            JsonValue root;
+            bool ok = parseValue(root);
+            skipSpace();
+            if (ok && p != end) ok = fail("Unexpected trailing characters in JSON.");
+            if (!ok) {
+                errorInfo = error;
+                return nullopt;
+            }
+            return root;
+        }
+    };
+
+    const JsonValue& JsonValue::null() {
+        static const JsonValue value{};
+        return value;
+    }
+
+    const JsonValue& JsonValue::operator[](const string& key) const {
+        for (auto& member : members) {
+            if (member.first == key) return member.second;
+        }
+        return null();
+    }
+
+    const JsonValue& JsonValue::operator[](size_t index) const {
+        return index < elements.size() ? elements[index] : null();
+    }
+
+    bool JsonValue::has(const string& key) const {
+        for (auto& member : members) {
+            if (member.first == key) return true;
+        }
+        return false;
+    }
+
+    optional<JsonValue> JsonValue::parse(string_view text, string& error) {
+        return JsonParser{text}.parse(error);
+    }
+} // namespace NRenderer
\ No newline at end of file
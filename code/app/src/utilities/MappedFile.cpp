@@ -0,0 +1,125 @@
+#include "utilities/MappedFile.hpp"
+
+#ifdef _WIN32
+#include "Windows.h"
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ڴӳļʵļ
+// Windowsʹļӳƽ̨ʹmmap
+
+namespace NRenderer
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const string& path)
+        : ptr               (nullptr)
+        , length            (0)
+        , fileHandle        (nullptr)
+        , mappingHandle     (nullptr)
+        , opened            (false)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE) return;
+        fileHandle = file;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            close();
+            return;
+        }
+        length = size_t(fileSize.QuadPart);
+        opened = true;
+        // ļܴӳ
+        if (length == 0) return;
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) {
+            close();
+            return;
+        }
+        mappingHandle = mapping;
+        ptr = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (ptr == nullptr) {
+            close();
+        }
+    }
+
+    void MappedFile::close() {
+        if (ptr != nullptr) UnmapViewOfFile(ptr);
+        if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+        if (fileHandle != nullptr) CloseHandle(fileHandle);
+        ptr = nullptr;
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : ptr               (other.ptr)
+        , length            (other.length)
+        , fileHandle        (other.fileHandle)
+        , mappingHandle     (other.mappingHandle)
+        , opened            (other.opened)
+    {
+        other.ptr = nullptr;
+        other.fileHandle = nullptr;
+        other.mappingHandle = nullptr;
+        other.length = 0;
+        other.opened = false;
+    }
+#else
+    MappedFile::MappedFile(const string& path)
+        : ptr               (nullptr)
+        , length            (0)
+        , fd                (-1)
+        , opened            (false)
+    {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close();
+            return;
+        }
+        length = size_t(st.st_size);
+        opened = true;
+        if (length == 0) return;
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close();
+            return;
+        }
+        madvise(p, length, MADV_SEQUENTIAL);
+        ptr = static_cast<const char*>(p);
+    }
+
+    void MappedFile::close() {
+        if (ptr != nullptr) munmap(const_cast<char*>(ptr), length);
+        if (fd >= 0) ::close(fd);
+        ptr = nullptr;
+        fd = -1;
+        length = 0;
+        opened = false;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : ptr               (other.ptr)
+        , length            (other.length)
+        , fd                (other.fd)
+        , opened            (other.opened)
+    {
+        other.ptr = nullptr;
+        other.fd = -1;
+        other.length = 0;
+        other.opened = false;
+    }
+#endif
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+} // namespace NRenderer
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <queue>
+#include <utility>
 
 namespace RayCast
 {
@@ -82,7 +84,44 @@ namespace RayCast
                 }
             }
         }
-        
+
+        // ںѡƽ, ڵݣ빹ɴ󶥶
+        using Candidate = std::pair<float, const T*>;
+        struct CandidateLess {
+            bool operator()(const Candidate& a, const Candidate& b) const { return a.first < b.first; }
+        };
+        using CandidateHeap = std::priority_queue<Candidate, std::vector<Candidate>, CandidateLess>;
+
+        // Kʼձǰkĵ
+        void nearestSearch(const std::shared_ptr<KDNode<T>>& node, const Vec3& position, size_t k,
+                        const std::function<bool(const T&)>& filter, CandidateHeap& heap) const {
+            if (!node) return;
+
+            Vec3 nodePos = getPosition(node->data);
+            Vec3 d = nodePos - position;
+            float dist2 = glm::dot(d, d);
+
+            if (!filter || filter(node->data)) {
+                if (heap.size() < k) {
+                    heap.push({dist2, &node->data});
+                } else if (dist2 < heap.top().first) {
+                    heap.pop();
+                    heap.push({dist2, &node->data});
+                }
+            }
+
+            int axis = node->axis;
+            float diff = position[axis] - nodePos[axis];
+            const auto& nearSide = diff <= 0 ? node->left : node->right;
+            const auto& farSide = diff <= 0 ? node->right : node->left;
+
+            nearestSearch(nearSide, position, k, filter, heap);
+            // ֻзָƽȵǰkĵʱҪһ
+            if (heap.size() < k || diff * diff < heap.top().first) {
+                nearestSearch(farSide, position, k, filter, heap);
+            }
+        }
+
     public:
         KDTree(const std::function<Vec3(const T&)>& getPos) : getPosition(getPos), root(nullptr) {}
         
@@ -100,7 +139,25 @@ namespace RayCast
             }
             return results;
         }
-        
+
+        // KڲѯɽԶ
+        // filter Ϊʱˣֻ filter Ϊĵ
+        std::vector<T> queryNearest(const Vec3& position, size_t k,
+                                    const std::function<bool(const T&)>& filter = nullptr) const {
+            std::vector<T> results;
+            if (!root || k == 0) return results;
+
+            CandidateHeap heap;
+            nearestSearch(root, position, k, filter, heap);
+
+            results.resize(heap.size());
+            for (size_t i = heap.size(); i > 0; --i) {
+                results[i - 1] = *heap.top().second;
+                heap.pop();
+            }
+            return results;
+        }
+
         // ǷΪ
         bool empty() const { return root == nullptr; }
     };
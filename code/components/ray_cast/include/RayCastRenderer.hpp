@@ -3,6 +3,9 @@
 #define __RAY_CAST_HPP__
 
 #include "scene/Scene.hpp"
+#include "scene/GeometryFlattener.hpp"
+#include "server/Framebuffer.hpp"
+#include "geometry/SphericalRectangle.hpp"
 #include "Camera.hpp"
 #include "intersections/intersections.hpp"
 #include "shaders/ShaderCreator.hpp"
@@ -21,13 +24,27 @@ namespace RayCast
     {
         Vec3 position;  // λ
         Vec3 direction; // ䷽
+        Vec3 normal;    // ڱķ
         RGB power;      // 
         int bounce;     // 
         int photonId;   // Ψһʶ
 
         Photon() = default;
-        Photon(const Vec3 &pos, const Vec3 &dir, const RGB &pwr, int bnc, int id)
-            : position(pos), direction(dir), power(pwr), bounce(bnc), photonId(id) {}
+        Photon(const Vec3 &pos, const Vec3 &dir, const Vec3 &nrm, const RGB &pwr, int bnc, int id)
+            : position(pos), direction(dir), normal(nrm), power(pwr), bounce(bnc), photonId(id) {}
+    };
+
+    // ԤնȲ㣨Christensen 
+    // ڲֹλԤܶȹƣȾʱֻһڲѯ
+    struct IrradiancePhoton
+    {
+        Vec3 position;  // λãȡԹλã
+        Vec3 normal;    // 淨
+        RGB irradiance; // Ԥķȹ
+
+        IrradiancePhoton() = default;
+        IrradiancePhoton(const Vec3 &pos, const Vec3 &nrm, const RGB &irr)
+            : position(pos), normal(nrm), irradiance(irr) {}
     };
 
     // ͼࣨʹKDŻ
@@ -37,14 +54,22 @@ namespace RayCast
         std::vector<Photon> photons;
         KDTree<Photon> kdTree;
 
+        // Ԥն
+        std::vector<IrradiancePhoton> irradiancePhotons;
+        KDTree<IrradiancePhoton> irradianceTree;
+
         // λûȡ
         static Vec3 getPhotonPosition(const Photon &photon)
         {
             return photon.position;
         }
+        static Vec3 getIrradiancePosition(const IrradiancePhoton &sample)
+        {
+            return sample.position;
+        }
 
     public:
-        PhotonMap() : kdTree(getPhotonPosition) {}
+        PhotonMap() : kdTree(getPhotonPosition), irradianceTree(getIrradiancePosition) {}
 
         void store(const Photon &photon)
         {
@@ -85,6 +110,16 @@ namespace RayCast
         // Ӧ뾶Ĺܶȹ
         RGB estimateRadianceAdaptive(const Vec3 &position, const Vec3 &normal, int nearestPhotons) const;
 
+        // Ԥնȣ buildKDTree ֮ã
+        // ÿ stride ȡһ㣬 nearestPhotons ܶȹƣִ߳
+        void precomputeIrradiance(int nearestPhotons, int stride = 4, unsigned int threadCount = 0);
+
+        // ѯԤķնȣֻһδԼڲѯ
+        // δԤҲһµĲʱ˻صӦ
+        RGB lookupIrradiance(const Vec3 &position, const Vec3 &normal, int nearestPhotons) const;
+
+        bool hasPrecomputedIrradiance() const { return !irradianceTree.empty(); }
+
         // ͳ
         RGB getTotalEnergy() const;
 
@@ -92,7 +127,13 @@ namespace RayCast
         RGB visualizePhotonDensity() const;
 
         // չͼ
-        void clear() { photons.clear(); }
+        void clear()
+        {
+            photons.clear();
+            irradiancePhotons.clear();
+            kdTree = KDTree<Photon>(getPhotonPosition);
+            irradianceTree = KDTree<IrradiancePhoton>(getIrradiancePosition);
+        }
     };
 
     class RayCastRenderer
@@ -102,22 +143,28 @@ namespace RayCast
         Scene &scene;
         RayCast::Camera camera;
         vector<SharedShader> shaderPrograms;
+        SharedFlatGeometry geometry; // չļ
 
         // ӳ
-        PhotonMap globalPhotonMap;
+        shared_ptr<const PhotonMap> globalPhotonMap; // ɵĹͼ뻺湲
         int photonCount;
         int maxBounces;
         bool usePhotonMapping;
+        bool usePrecomputedIrradiance; // ǷʹԤն
+        constexpr static int areaLightSamples = 16; // ÿԴֱӹղ
         int nextPhotonId; // ΨһID
+        Framebuffer framebuffer; // ɫAOVͨ
 
     public:
         RayCastRenderer(SharedScene spScene)
-            : spScene(spScene), scene(*spScene), camera(spScene->camera), photonCount(10000) // ĬϹ
+            : spScene(spScene), scene(*spScene), camera(spScene->camera), globalPhotonMap(make_shared<const PhotonMap>()), photonCount(10000) // ĬϹ
               ,
               maxBounces(5) // 󷴵
               ,
               usePhotonMapping(true) // Ĭʹùӳ
               ,
+              usePrecomputedIrradiance(false) // Ĭܶȹ
+              ,
               nextPhotonId(0) // ID0ʼ
         {
         }
@@ -130,10 +177,10 @@ namespace RayCast
         void release(const RenderResult &r);
 
         // ӳط
-        void buildPhotonMap();
-        void tracePhoton(const Ray &ray, RGB power, int bounce, int &storedCount,
+        shared_ptr<PhotonMap> buildPhotonMap();
+        void tracePhoton(PhotonMap &photonMap, const Ray &ray, RGB power, int bounce, int &storedCount,
                          int photonId, std::unordered_set<int> &storedPhotonIds);
-        RGB getPhotonEnergy() const { return globalPhotonMap.getTotalEnergy(); }
+        RGB getPhotonEnergy() const { return globalPhotonMap->getTotalEnergy(); }
 
         // غ֤
         void verifyEnergyConservation();
@@ -142,15 +189,25 @@ namespace RayCast
         void setPhotonCount(int count) { photonCount = count; }
         void setMaxBounces(int bounces) { maxBounces = bounces; }
         void setUsePhotonMapping(bool use) { usePhotonMapping = use; }
-        int getStoredPhotonCount() const { return globalPhotonMap.size(); }
+        void setUsePrecomputedIrradiance(bool use) { usePrecomputedIrradiance = use; }
+        int getStoredPhotonCount() const { return globalPhotonMap->size(); }
         bool isLambertianMaterial(int materialIndex) const;
 
         bool isDielectricMaterial(int materialIndex) const;
 
+        // ȡȾ֡壨ɫߡȡͼԪ±꣩
+        const Framebuffer &getFramebuffer() const { return framebuffer; }
+
     private:
         RGB gamma(const RGB &rgb);
         RGB trace(const Ray &r);
+        RGB trace(const Ray &r, const HitRecord &hitRecord);
         HitRecord closestHit(const Ray &r);
+        // һͼԪвұclosestཻͼԪ±primitiveBaseʼҵʱclosestclosestHit
+        bool closestHitInRange(const Ray &r, const FlatRange &range, size_t primitiveBase, float &closest, HitRecord &closestHit) const;
+
+        // ԴֱӹգιԴǲ
+        RGB directAreaLight(const Ray &r, const HitRecordBase &rec);
 
         // ˹̶
 
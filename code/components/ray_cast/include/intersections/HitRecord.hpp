@@ -22,6 +22,7 @@ namespace RayCast
         Vec3 hitPoint;   // ཻ
         Vec3 normal;     // ཻ㷨
         Handle material; // ཻĲ
+        unsigned int primitive = 0; // ཻͼԪ±꣨Ϊ塢Ρƽ棩
     };
 
     // ཻ¼
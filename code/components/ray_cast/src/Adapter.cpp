@@ -19,11 +19,13 @@ namespace RayCast
 			renderer.setPhotonCount(100);		 // Ĭ10000
 			renderer.setMaxBounces(5);			 // 󷴵5
 			renderer.setUsePhotonMapping(true); // ùӳ
+			renderer.setUsePrecomputedIrradiance(true); // Ԥλõķն
 
 			auto result = renderer.render();
 
 			// ȡȾõĻ
 			auto [pixels, width, height] = result;
+			getServer().screen.setFramebuffer(renderer.getFramebuffer());
 			getServer().screen.set(pixels, width, height);
 
 			// ͷȾ
@@ -37,6 +39,7 @@ const static string description =
 "Features:\n"
 " - Photon Mapping Algorithm\n"
 " - KD-Tree Accelerated Photon Search\n"
+" - Precomputed Irradiance at Photon Positions\n"
 " - Global Photon Map\n"
 " - Direct + Indirect Lighting\n"
 " - Shadow Calculation\n"
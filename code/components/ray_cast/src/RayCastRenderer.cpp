@@ -1,14 +1,31 @@
 #include "RayCastRenderer.hpp"
-#include "VertexTransformer.hpp"
 #include "intersections/intersections.hpp"
 #include <random>
 #include <iostream>
 #include <chrono>
 #include <algorithm>
 #include <unordered_set>
+#include <thread>
+#include <mutex>
 
 namespace RayCast
 {
+	// ϴȾĹͼ
+	// ÿȾᴴµȾͼֻ뼸塢ʡԴӲйأ
+	// Щδ޸ʱֻƶֱӸã·
+	struct PhotonMapCache
+	{
+		std::mutex lock;
+		bool valid = false;
+		SceneVersion version;
+		int photonCount = 0;
+		int maxBounces = 0;
+		bool precomputed = false;
+		// ɺ޸ģȾлʱƹKD
+		std::shared_ptr<const PhotonMap> photonMap;
+	};
+	static PhotonMapCache photonMapCache;
+
 	void RayCastRenderer::release(const RenderResult &r)
 	{
 		auto [p, w, h] = r;
@@ -220,9 +237,10 @@ namespace RayCast
 		}
 
 		std::cout << "ͳ:" << std::endl;
-		std::cout << "  : " << scene.triangleBuffer.size() << std::endl;
-		std::cout << "  : " << scene.sphereBuffer.size() << std::endl;
-		std::cout << "  ƽ: " << scene.planeBuffer.size() << std::endl;
+		std::cout << "  : " << geometry->triangles.size() << std::endl;
+		std::cout << "  : " << geometry->spheres.size() << std::endl;
+		std::cout << "  ƽ: " << geometry->planes.size() << std::endl;
+		std::cout << "  ģʵ: " << geometry->instances.size() << std::endl;
 
 		std::cout << "Դͳ:" << std::endl;
 		std::cout << "  Դ: " << scene.pointLightBuffer.size() << std::endl;
@@ -243,15 +261,15 @@ namespace RayCast
 		}
 	}
 
-	void RayCastRenderer::buildPhotonMap()
+	std::shared_ptr<PhotonMap> RayCastRenderer::buildPhotonMap()
 	{
-		globalPhotonMap.clear();
+		auto photonMap = std::make_shared<PhotonMap>();
 		nextPhotonId = 0;
 
 		if (scene.pointLightBuffer.empty())
 		{
 			std::cout << ": ûеԴ" << std::endl;
-			return;
+			return photonMap;
 		}
 
 		auto &light = scene.pointLightBuffer[0];
@@ -301,13 +319,13 @@ namespace RayCast
 			// ʹĳʼ
 			RGB power = initialPower;
 
-			tracePhoton(ray, power, 0, storedPhotons, photonId, storedPhotonIds);
+			tracePhoton(*photonMap, ray, power, 0, storedPhotons, photonId, storedPhotonIds);
 		}
 
 		// KDٽṹ
 		std::cout << "KDٽṹ..." << std::endl;
 		auto kdTreeStart = std::chrono::steady_clock::now();
-		globalPhotonMap.buildKDTree();
+		photonMap->buildKDTree();
 		auto kdTreeEnd = std::chrono::steady_clock::now();
 		auto kdTreeTime = std::chrono::duration_cast<std::chrono::milliseconds>(kdTreeEnd - kdTreeStart).count();
 
@@ -333,6 +351,7 @@ namespace RayCast
 		{
 			std::cout << "ͼɹ" << std::endl;
 		}
+		return photonMap;
 	}
 	bool RayCastRenderer::isLambertianMaterial(int materialIndex) const
 	{
@@ -356,7 +375,7 @@ namespace RayCast
 		return material.type == 2; // 2ʾGlass
 	}
 
-	void RayCastRenderer::tracePhoton(const Ray &ray, RGB power, int bounce, int &storedCount,
+	void RayCastRenderer::tracePhoton(PhotonMap &photonMap, const Ray &ray, RGB power, int bounce, int &storedCount,
 									  int photonId, std::unordered_set<int> &storedPhotonIds)
 	{
 		static int totalTraces = 0;
@@ -420,7 +439,7 @@ namespace RayCast
 			{
 				Vec3 reflectDir = Glass::reflect(rec.normal, ray.direction);
 				Ray reflectRay(rec.hitPoint + rec.normal * 0.001f, reflectDir);
-				tracePhoton(reflectRay, reflectPower, bounce + 1, storedCount, photonId, storedPhotonIds);
+				tracePhoton(photonMap, reflectRay, reflectPower, bounce + 1, storedCount, photonId, storedPhotonIds);
 			}
 
 			// ֧
@@ -432,7 +451,7 @@ namespace RayCast
 				if ((refractPower.r + refractPower.g + refractPower.b) > 1e-6f)
 				{
 					Ray refractRay(rec.hitPoint - rec.normal * 0.001f, refractDir);
-					tracePhoton(refractRay, refractPower, bounce + 1, storedCount, photonId, storedPhotonIds);
+					tracePhoton(photonMap, refractRay, refractPower, bounce + 1, storedCount, photonId, storedPhotonIds);
 				}
 			}
 
@@ -459,8 +478,8 @@ namespace RayCast
 
 					if (dis_store(gen_store) < storeProbability)
 					{
-						Photon photon(rec.hitPoint, -ray.direction, power, bounce, photonId);
-						globalPhotonMap.store(photon);
+						Photon photon(rec.hitPoint, -ray.direction, rec.normal, power, bounce, photonId);
+						photonMap.store(photon);
 						storedPhotonIds.insert(photonId);
 						storedCount++;
 
@@ -504,7 +523,7 @@ namespace RayCast
 			}
 
 			Ray newRay(rec.hitPoint + rec.normal * 0.001f, glm::normalize(newDirection));
-			tracePhoton(newRay, newPower, bounce + 1, storedCount, photonId, storedPhotonIds);
+			tracePhoton(photonMap, newRay, newPower, bounce + 1, storedCount, photonId, storedPhotonIds);
 			return;
 		}
 
@@ -582,16 +601,29 @@ namespace RayCast
 		// ҵN
 		std::vector<std::pair<float, const Photon *>> photonDistances;
 
-		for (const auto &photon : photons)
+		std::vector<Photon> nearest;
+		if (!kdTree.empty())
 		{
-			float distance = glm::length(photon.position - position);
-			photonDistances.emplace_back(distance, &photon);
+			// KDKڲѯѰ
+			nearest = kdTree.queryNearest(position, nearestPhotons);
+			for (const auto &photon : nearest)
+			{
+				photonDistances.emplace_back(glm::length(photon.position - position), &photon);
+			}
 		}
+		else
+		{
+			for (const auto &photon : photons)
+			{
+				float distance = glm::length(photon.position - position);
+				photonDistances.emplace_back(distance, &photon);
+			}
 
-		// 
-		std::sort(photonDistances.begin(), photonDistances.end(),
-				  [](const auto &a, const auto &b)
-				  { return a.first < b.first; });
+			// 
+			std::sort(photonDistances.begin(), photonDistances.end(),
+					  [](const auto &a, const auto &b)
+					  { return a.first < b.first; });
+		}
 
 		// ȷ㹻Ĺ
 		if (photonDistances.size() < nearestPhotons)
@@ -640,6 +672,64 @@ namespace RayCast
 
 		return RGB(0);
 	}
+
+	// Ԥնȣڲֹλǰܶȹ
+	void PhotonMap::precomputeIrradiance(int nearestPhotons, int stride, unsigned int threadCount)
+	{
+		irradiancePhotons.clear();
+		irradianceTree = KDTree<IrradiancePhoton>(getIrradiancePosition);
+
+		if (photons.empty() || nearestPhotons <= 0)
+			return;
+		if (stride < 1)
+			stride = 1;
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		size_t sampleCount = (photons.size() + stride - 1) / stride;
+		irradiancePhotons.resize(sampleCount);
+
+		// ÿ̰߳㣬дԵλã
+		auto task = [&](unsigned int off)
+		{
+			for (size_t i = off; i < sampleCount; i += threadCount)
+			{
+				const Photon &photon = photons[i * stride];
+				RGB irradiance = estimateRadianceAdaptive(photon.position, photon.normal, nearestPhotons);
+				irradiancePhotons[i] = IrradiancePhoton(photon.position, photon.normal, irradiance);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (unsigned int t = 0; t < threadCount; ++t)
+		{
+			workers.emplace_back(task, t);
+		}
+		for (auto &w : workers)
+		{
+			w.join();
+		}
+
+		irradianceTree.build(irradiancePhotons);
+	}
+
+	// ѯԤն
+	RGB PhotonMap::lookupIrradiance(const Vec3 &position, const Vec3 &normal, int nearestPhotons) const
+	{
+		if (irradianceTree.empty())
+			return estimateRadianceAdaptive(position, normal, nearestPhotons);
+
+		// ֻܷ߷ӽĲ㣬ǽǴȡһķն
+		auto nearest = irradianceTree.queryNearest(position, 1,
+			[&normal](const IrradiancePhoton &sample)
+			{ return glm::dot(sample.normal, normal) > 0.9f; });
+
+		if (nearest.empty())
+			return estimateRadianceAdaptive(position, normal, nearestPhotons);
+
+		return nearest[0].irradiance;
+	}
+
 	// ܶȿӻ
 	RGB PhotonMap::visualizePhotonDensity() const
 	{
@@ -663,10 +753,10 @@ namespace RayCast
 	// ӿӻȾ
 	RGB RayCastRenderer::renderPhotonVisualization()
 	{
-		if (globalPhotonMap.size() == 0)
+		if (globalPhotonMap->size() == 0)
 			return RGB(0, 0, 0);
 
-		float intensity = std::min(1.0f, globalPhotonMap.size() / 10000.0f);
+		float intensity = std::min(1.0f, globalPhotonMap->size() / 10000.0f);
 		return RGB(intensity, intensity, intensity);
 	}
 
@@ -676,9 +766,18 @@ namespace RayCast
 		auto height = scene.renderOption.height;
 		auto pixels = new RGBA[width * height];
 
-		// ִж任
-		VertexTransformer vertexTransformer{};
-		vertexTransformer.exec(spScene);
+		// Ⱦÿһṩ뷽ͨ
+		using Channel = Framebuffer::Channel;
+		framebuffer = Framebuffer{width, height};
+		framebuffer.add(Channel::BEAUTY);
+		framebuffer.add(Channel::NORMAL);
+		framebuffer.add(Channel::DEPTH);
+		framebuffer.add(Channel::MATERIAL_ID, -1.f);
+		framebuffer.add(Channel::PRIMITIVE_ID, -1.f);
+		framebuffer.add(Channel::SAMPLE_COUNT, 1.f);
+
+		// 尴ģͱ任չ꣬޸
+		geometry = GeometryFlattener::get(scene);
 
 		// 
 		analyzeScene();
@@ -686,7 +785,43 @@ namespace RayCast
 		// ͼ
 		if (usePhotonMapping)
 		{
-			buildPhotonMap();
+			std::lock_guard<std::mutex> guard{photonMapCache.lock};
+			auto &version = scene.version;
+			auto &cache = photonMapCache;
+			if (cache.valid && version.known()
+				&& cache.version.geometry == version.geometry
+				&& cache.version.material == version.material
+				&& cache.version.texture == version.texture
+				&& cache.version.light == version.light
+				&& cache.photonCount == photonCount
+				&& cache.maxBounces == maxBounces
+				&& cache.precomputed == usePrecomputedIrradiance)
+			{
+				std::cout << "δ޸ģϴεĹͼ" << std::endl;
+				globalPhotonMap = cache.photonMap;
+			}
+			else
+			{
+				auto photonMap = buildPhotonMap();
+
+				if (usePrecomputedIrradiance && photonMap->size() > 0)
+				{
+					std::cout << "Ԥλõķն..." << std::endl;
+					auto irradianceStart = std::chrono::steady_clock::now();
+					photonMap->precomputeIrradiance(50);
+					auto irradianceEnd = std::chrono::steady_clock::now();
+					auto irradianceTime = std::chrono::duration_cast<std::chrono::milliseconds>(irradianceEnd - irradianceStart).count();
+					std::cout << "նԤʱ: " << irradianceTime << " " << std::endl;
+				}
+
+				cache.valid = version.known();
+				cache.version = version;
+				cache.photonCount = photonCount;
+				cache.maxBounces = maxBounces;
+				cache.precomputed = usePrecomputedIrradiance;
+				globalPhotonMap = photonMap;
+				cache.photonMap = globalPhotonMap;
+			}
 		}
 		else
 		{
@@ -710,13 +845,22 @@ namespace RayCast
 			for (int j = 0; j < width; j++)
 			{
 				RGB finalColor(0, 0, 0);
+				unsigned int index = (height - i - 1) * width + j;
 
-				if (usePhotonMapping && globalPhotonMap.size() > 0)
+				// ֻһΣͬʱɫAOVͨ
+				auto ray = camera.shoot(float(j) / float(width), float(i) / float(height));
+				auto hitRecord = closestHit(ray);
+				if (hitRecord)
 				{
-					// ӳģʽ
-					auto ray = camera.shoot(float(j) / float(width), float(i) / float(height));
-					auto hitRecord = closestHit(ray);
+					framebuffer.set(Channel::NORMAL, index, hitRecord->normal);
+					framebuffer.set(Channel::DEPTH, index, hitRecord->t);
+					framebuffer.set(Channel::MATERIAL_ID, index, float(hitRecord->material.index()));
+					framebuffer.set(Channel::PRIMITIVE_ID, index, float(hitRecord->primitive));
+				}
 
+				if (usePhotonMapping && globalPhotonMap->size() > 0)
+				{
+					// ӳģʽ
 					if (hitRecord)
 					{
 						auto &rec = *hitRecord;
@@ -731,7 +875,7 @@ namespace RayCast
 									  << rec.normal.y << ", " << rec.normal.z << ")" << std::endl;
 
 							// Թͼѯ
-							auto nearbyPhotons = globalPhotonMap.queryRange(rec.hitPoint, 50.0f);
+							auto nearbyPhotons = globalPhotonMap->queryRange(rec.hitPoint, 50.0f);
 							std::cout << "  : " << nearbyPhotons.size() << std::endl;
 
 							if (!nearbyPhotons.empty())
@@ -740,8 +884,10 @@ namespace RayCast
 										  << nearbyPhotons[0].power.g << ", " << nearbyPhotons[0].power.b << ")" << std::endl;
 							}
 						}
-						// ʹӦ뾶ӹ
-						RGB indirectRadiance = globalPhotonMap.estimateRadianceAdaptive(rec.hitPoint, rec.normal, 50);
+						// ʹӦ뾶ӹգԤʱֻһڲѯ
+						RGB indirectRadiance = usePrecomputedIrradiance
+												   ? globalPhotonMap->lookupIrradiance(rec.hitPoint, rec.normal, 50)
+												   : globalPhotonMap->estimateRadianceAdaptive(rec.hitPoint, rec.normal, 50);
 						if (i == height / 2 && j == width / 2)
 						{
 							std::cout << "  Ƶļӹ: (" << indirectRadiance.r << ", "
@@ -768,6 +914,7 @@ namespace RayCast
 							directRadiance = shaderPrograms[rec.material.index()]->shade(-ray.direction, lightDir, rec.normal);
 							directRadiance *= light.intensity * shadowFactor;
 						}
+						directRadiance += directAreaLight(ray, rec);
 
 						// ɫ = ֱӹ + ӹ
 						finalColor = directRadiance + indirectRadiance * 100.0f;
@@ -780,13 +927,13 @@ namespace RayCast
 				else
 				{
 					// ͳ׷ģʽ
-					auto ray = camera.shoot(float(j) / float(width), float(i) / float(height));
-					finalColor = trace(ray);
+					finalColor = trace(ray, hitRecord);
 				}
 
 				finalColor = clamp(finalColor);
+				framebuffer.set(Channel::BEAUTY, index, finalColor);
 				finalColor = gamma(finalColor);
-				pixels[(height - i - 1) * width + j] = {finalColor, 1};
+				pixels[index] = {finalColor, 1};
 			}
 		}
 
@@ -795,7 +942,7 @@ namespace RayCast
 		std::cout << "Ⱦɣʱ " << renderTime << " " << std::endl;
 
 		// غ֤
-		if (usePhotonMapping && globalPhotonMap.size() > 0)
+		if (usePhotonMapping && globalPhotonMap->size() > 0)
 		{
 			verifyEnergyConservation();
 		}
@@ -816,7 +963,7 @@ namespace RayCast
 		// ֻӣʹ 2
 		RGB emittedEnergy = light.intensity * (2.0f * PI);
 
-		RGB storedEnergy = globalPhotonMap.getTotalEnergy();
+		RGB storedEnergy = globalPhotonMap->getTotalEnergy();
 
 		std::cout << "=== غ֤ ===" << std::endl;
 		std::cout << "Դ: (" << emittedEnergy.r << ", " << emittedEnergy.g << ", " << emittedEnergy.b << ")" << std::endl;
@@ -856,10 +1003,15 @@ namespace RayCast
 
 	RGB RayCastRenderer::trace(const Ray &r)
 	{
-		auto hitRecord = closestHit(r);
+		return trace(r, closestHit(r));
+	}
+
+	RGB RayCastRenderer::trace(const Ray &r, const HitRecord &hitRecord)
+	{
 		if (hitRecord)
 		{
 			auto &rec = *hitRecord;
+			RGB color(0, 0, 0);
 
 			if (scene.pointLightBuffer.size() > 0)
 			{
@@ -868,48 +1020,117 @@ namespace RayCast
 
 				if (glm::dot(out, rec.normal) > 0)
 				{
-					return shaderPrograms[rec.material.index()]->shade(-r.direction, out, rec.normal) * light.intensity;
+					color = shaderPrograms[rec.material.index()]->shade(-r.direction, out, rec.normal) * light.intensity;
 				}
 			}
+			return color + directAreaLight(r, rec);
 		}
 		return RGB(0, 0, 0);
 	}
 
+	// Դֱӹ
+	// ɫ diffuse*cosԦеõ BRDF*cosԴϵĲ ParallelogramSampler 
+	// ĴιԴǲԶСڰ
+	RGB RayCastRenderer::directAreaLight(const Ray &r, const HitRecordBase &rec)
+	{
+		static std::mt19937 gen(std::random_device{}());
+		std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+
+		RGB result(0, 0, 0);
+		auto &shader = shaderPrograms[rec.material.index()];
+		for (auto &a : scene.areaLightBuffer)
+		{
+			ParallelogramSampler lightSampler(rec.hitPoint, a.position, a.u, a.v);
+			RGB sum(0, 0, 0);
+			for (int s = 0; s < areaLightSamples; ++s)
+			{
+				float su = dis(gen);
+				float sv = dis(gen);
+				float pdf;
+				Vec3 lightPoint = lightSampler.sample({su, sv}, pdf);
+				if (pdf <= 0)
+					continue;
+
+				Vec3 toLight = lightPoint - rec.hitPoint;
+				float distance = glm::length(toLight);
+				if (distance <= 0)
+					continue;
+				Vec3 dir = toLight / distance;
+				if (glm::dot(dir, rec.normal) <= 0)
+					continue;
+
+				// Ӱ⣬ԶڹԴԱԴƽཻ
+				auto shadowHit = closestHit(Ray(rec.hitPoint, dir));
+				if (shadowHit && shadowHit->t < distance * (1.0f - 0.0001f))
+					continue;
+
+				sum += shader->shade(-r.direction, dir, rec.normal) * a.radiance / (PI * pdf);
+			}
+			result += sum / float(areaLightSamples);
+		}
+		return result;
+	}
+
+	// ȱеͼԪٰѹ߱任ʵģͿռбģ͵ͼԪ
 	HitRecord RayCastRenderer::closestHit(const Ray &r)
 	{
 		HitRecord closestHit = nullopt;
 		float closest = FLOAT_INF;
+		closestHitInRange(r, geometry->world, 0, closest, closestHit);
+		for (auto &instance : geometry->instances)
+		{
+			// 򲻹һģͿռеtеt
+			Ray local{instance.localPoint(r.origin), instance.localDirection(r.direction)};
+			if (closestHitInRange(local, instance.range, instance.primitiveBase, closest, closestHit))
+			{
+				closestHit->hitPoint = r.at(closestHit->t);
+				closestHit->normal = instance.worldNormal(closestHit->normal);
+			}
+		}
+		return closestHit;
+	}
+
+	bool RayCastRenderer::closestHitInRange(const Ray &r, const FlatRange &range, size_t primitiveBase, float &closest, HitRecord &closestHit) const
+	{
+		bool found = false;
+		unsigned int primitive = unsigned(primitiveBase); // ͼԪ±꣬Ϊ塢Ρƽ
 
-		for (auto &s : scene.sphereBuffer)
+		for (size_t i = range.sphereBegin; i < range.sphereEnd; i++, primitive++)
 		{
-			auto hitRecord = Intersection::xSphere(r, s, 0.01, closest);
+			auto hitRecord = Intersection::xSphere(r, geometry->spheres[i], 0.01, closest);
 			if (hitRecord && hitRecord->t < closest)
 			{
 				closest = hitRecord->t;
 				closestHit = hitRecord;
+				closestHit->primitive = primitive;
+				found = true;
 			}
 		}
 
-		for (auto &t : scene.triangleBuffer)
+		for (size_t i = range.triangleBegin; i < range.triangleEnd; i++, primitive++)
 		{
-			auto hitRecord = Intersection::xTriangle(r, t, 0.01, closest);
+			auto hitRecord = Intersection::xTriangle(r, geometry->triangles[i], 0.01, closest);
 			if (hitRecord && hitRecord->t < closest)
 			{
 				closest = hitRecord->t;
 				closestHit = hitRecord;
+				closestHit->primitive = primitive;
+				found = true;
 			}
 		}
 
-		for (auto &p : scene.planeBuffer)
+		for (size_t i = range.planeBegin; i < range.planeEnd; i++, primitive++)
 		{
-			auto hitRecord = Intersection::xPlane(r, p, 0.01, closest);
+			auto hitRecord = Intersection::xPlane(r, geometry->planes[i], 0.01, closest);
 			if (hitRecord && hitRecord->t < closest)
 			{
 				closest = hitRecord->t;
 				closestHit = hitRecord;
+				closestHit->primitive = primitive;
+				found = true;
 			}
 		}
 
-		return closestHit;
+		return found;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef __ALIAS_TABLE_HPP__
+#define __ALIAS_TABLE_HPP__
+
+#include <vector>
+#include <algorithm>
+
+namespace SimplePathTracer
+{
+    using namespace std;
+
+    /**
+     * Vose
+     * [0,1)ϵķֶγֲO(1)ÿΪ1/n
+     * ʱͬһѡ䲢õڵλ
+     */
+    class AliasTable
+    {
+    private:
+        vector<float> probability;      // ѡб䣨Ǳĸ
+        vector<unsigned int> alias;     // 
+        vector<float> pdfs;             // ÿĸܶȣ[0,1)
+        float integral;                 // ֵƽֵ
+
+    public:
+        AliasTable() : integral(0) {}
+
+        /**
+         * 캯
+         * @param func ǸķֶγֵȫΪ0ʱ˻Ϊȷֲ
+         */
+        explicit AliasTable(const vector<float>& func) {
+            auto n = func.size();
+            probability.assign(n, 1.f);
+            alias.resize(n);
+            pdfs.assign(n, 1.f);
+            integral = 0;
+            for (auto f : func) integral += f;
+            integral /= float(max<size_t>(n, 1));
+            if (n == 0 || integral <= 0) {
+                for (unsigned int i = 0; i < n; i++) alias[i] = i;
+                return;
+            }
+
+            // źĸʰΪƫСƫ飬
+            vector<float> scaled(n);
+            vector<unsigned int> small, large;
+            for (unsigned int i = 0; i < n; i++) {
+                pdfs[i] = func[i] / integral;
+                scaled[i] = pdfs[i];
+                (scaled[i] < 1.f ? small : large).push_back(i);
+            }
+            while (!small.empty() && !large.empty()) {
+                auto s = small.back(); small.pop_back();
+                auto l = large.back(); large.pop_back();
+                probability[s] = scaled[s];
+                alias[s] = l;
+                scaled[l] = (scaled[l] + scaled[s]) - 1.f;
+                (scaled[l] < 1.f ? small : large).push_back(l);
+            }
+            // ʣɸɣΪ1
+            for (auto i : small) { probability[i] = 1.f; alias[i] = i; }
+            for (auto i : large) { probability[i] = 1.f; alias[i] = i; }
+        }
+
+        /**
+         * 
+         * @param u [0,1)ڵ
+         * @param pdf ĸܶ
+         * @param offset ѡе
+         * @return [0,1)ڵĲ
+         */
+        float sample(float u, float& pdf, unsigned int& offset) const {
+            auto n = probability.size();
+            float scaled = u * float(n);
+            unsigned int i = min(unsigned(scaled), unsigned(n - 1));
+            float frac = scaled - float(i);
+            // µСӳΪڵλ
+            if (frac < probability[i]) {
+                frac = frac / probability[i];
+                offset = i;
+            }
+            else {
+                frac = (frac - probability[i]) / (1.f - probability[i]);
+                offset = alias[i];
+            }
+            pdf = pdfs[offset];
+            return min((float(offset) + frac) / float(n), 0x1.fffffep-1f);
+        }
+
+        /**
+         * ĸܶ
+         * @param i ±
+         * @return ܶ
+         */
+        float pdf(unsigned int i) const {
+            return pdfs[i];
+        }
+
+        /**
+         * ֵƽֵ[0,1)ϵĻ֣
+         */
+        float getIntegral() const {
+            return integral;
+        }
+
+        /**
+         * 
+         */
+        unsigned int size() const {
+            return unsigned(probability.size());
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -28,13 +28,16 @@ namespace SimplePathTracer
         Vec3 horizontal;                  // ˮƽ
         Vec3 lowerLeft;                   // ƽ½λ
         Vec3 position;                    // λ
+        float pixelSpread;                // ضӦĹ׶Ž
     public:
         /**
          * 캯ʼ
          * @param camera ԭʼ
+         * @param imageHeight ͼ߶ȣأڼ׶ŽǣΪ0ʱ߲׶
          */
-        Camera(const NRenderer::Camera& camera)
+        Camera(const NRenderer::Camera& camera, unsigned int imageHeight = 0)
             : camera                (camera)
+            , pixelSpread           (0.f)
         {
             position = camera.position;
             lenRadius = camera.aperture / 2.f;  // 㾵ͷ뾶
@@ -59,6 +62,10 @@ namespace SimplePathTracer
                 - focusDis*w;
             horizontal = 2*halfWidth*focusDis*u;
             vertical = 2*halfHeight*focusDis*v;
+
+            if (imageHeight > 0) {
+                pixelSpread = atan(2.f*halfHeight / float(imageHeight));
+            }
         }
 
         /**
@@ -75,12 +82,15 @@ namespace SimplePathTracer
             Vec3 offset = u*rx + v*ry;
             
             // ͷ
-            return Ray{
+            Ray ray{
                 position + offset,  // 㣨Ǿͷƫƣ
                 glm::normalize(
                     lowerLeft + s*horizontal + t*vertical - position - offset
                 )
             };
+            // ŽǸһ
+            ray.coneSpread = pixelSpread;
+            return ray;
         }
     };
 }
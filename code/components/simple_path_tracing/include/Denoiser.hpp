@@ -0,0 +1,69 @@
+#pragma once
+#ifndef __DENOISER_HPP__
+#define __DENOISER_HPP__
+
+#include "geometry/vec.hpp"
+#include "server/Framebuffer.hpp"
+
+#include <vector>
+
+namespace SimplePathTracer
+{
+    using namespace NRenderer;
+    using namespace std;
+
+    /**
+     * 
+     */
+    struct DenoiseOptions
+    {
+        unsigned int iterations = 5;    // iεĲΪ2^i
+        float sigmaColor = 0.5f;        // ɫȨصĳ߶ȣÿε
+        float sigmaNormal = 64.f;       // Ȩصָ
+        float sigmaDepth = 0.05f;       // Ȳĳ߶ȣÿؼ
+    };
+
+    /**
+     * ԵֵA-TrousС
+     * ÷ʶɫȥƵõգڹμμӱ5x5 B3˲
+     * ԷߡȺɫΪԵֹͣȨأٳ˻طԱϸ
+     */
+    class Denoiser
+    {
+    private:
+        unsigned int width;         // ͼ
+        unsigned int height;        // ͼ߶
+        unsigned int threads;       // ߳0ʾʹӲ
+        DenoiseOptions options;     // 
+
+        /**
+         * һA-Trous˲[rowBegin, rowEnd)ڵ
+         */
+        void filterRows(const vector<Vec3>& in, vector<Vec3>& out, const Framebuffer& guide,
+            int stepSize, float sigmaColor, unsigned int rowBegin, unsigned int rowEnd) const;
+
+    public:
+        /**
+         * 캯
+         * @param width ͼ
+         * @param height ͼ߶
+         * @param threads ߳0ʾʹӲ
+         * @param options 
+         */
+        Denoiser(unsigned int width, unsigned int height, unsigned int threads, const DenoiseOptions& options = {})
+            : width                 (width)
+            , height                (height)
+            , threads               (threads)
+            , options               (options)
+        {}
+
+        /**
+         * 
+         * ֡BEAUTYALBEDONORMALDEPTHͨдBEAUTYͨ
+         * @param framebuffer ֡
+         */
+        void denoise(Framebuffer& framebuffer) const;
+    };
+}
+
+#endif
\ No newline at end of file
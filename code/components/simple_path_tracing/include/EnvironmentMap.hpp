@@ -0,0 +1,68 @@
+#pragma once
+#ifndef __ENVIRONMENT_MAP_HPP__
+#define __ENVIRONMENT_MAP_HPP__
+
+#include "scene/Texture.hpp"
+#include "geometry/vec.hpp"
+#include "AliasTable.hpp"
+
+#include <vector>
+
+namespace SimplePathTracer
+{
+    using namespace NRenderer;
+    using namespace std;
+
+    /**
+     * ͼԴ
+     * γȣequirectangularͼyᳯϣͼһжӦϷ
+     * ȳsinȹάֶγֲ
+     * ñԵֲıѡУøֲıѡ
+     */
+    class EnvironmentMap
+    {
+    private:
+        Texture texture;                    // ͼؿ볡ڶȾ仺
+        AliasTable marginal;                // еıԵֲ
+        vector<AliasTable> conditional;     // ÿһеֲ
+
+        /**
+         * ȡͼ
+         */
+        RGB texel(unsigned int x, unsigned int y) const;
+
+    public:
+        /**
+         * 캯ͼȹֲ
+         * @param texture ͼ
+         */
+        EnvironmentMap(const Texture& texture);
+
+        /**
+         * ѯϵĻ
+         * @param direction λ
+         * @param coneSpread ׶ŽǣǶʱӶ༶ԶĽϴּȡ
+         *                   MISĹ߱봫0samplepdfʹõĵ0һ
+         * @return 
+         */
+        RGB eval(const Vec3& direction, float coneSpread = 0.f) const;
+
+        /**
+         * ͼȲһ
+         * @param u [0,1)^2ڵ
+         * @param direction λ
+         * @param pdf Ƕĸܶ
+         * @return ÷ķ
+         */
+        RGB sample(const Vec2& u, Vec3& direction, float& pdf) const;
+
+        /**
+         * ĸܶȣǶ
+         * @param direction λ
+         * @return ܶ
+         */
+        float pdf(const Vec3& direction) const;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef __LIGHT_BVH_HPP__
+#define __LIGHT_BVH_HPP__
+
+#include "scene/Light.hpp"
+#include "geometry/vec.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+
+namespace SimplePathTracer
+{
+    using namespace NRenderer;
+    using namespace std;
+
+    /**
+     * һԴİΧϢ
+     * ΧСⷽ׶ǣܹʣڹƹԴɫҪ
+     */
+    struct LightBounds
+    {
+        Vec3 min{FLT_MAX};          // ΧС
+        Vec3 max{-FLT_MAX};         // Χ
+        Vec3 axis{0, 0, 1};         // ⷽ׶
+        float cosThetaO = 1.f;      // ߷׶İ
+        float cosThetaE = 0.f;      // ÿ߷ΧⷶΧİ
+        float power = 0.f;          // ܹʣȣ
+        bool twoSided = false;      // Ƿ˫淢
+
+        /**
+         * ƹԴɫҪ
+         * ڰΧŽǶȷΧȡⷽ䷽ļнǣ֤Ǳع
+         * @param p ɫ
+         * @param n ɫ㷨ߣΪ0ʱ
+         * @return ҪԣΪ0ʾй
+         */
+        float importance(const Vec3& p, const Vec3& n) const;
+
+        /**
+         * ϲԴİΧϢ
+         */
+        static LightBounds merge(const LightBounds& a, const LightBounds& b);
+    };
+
+    /**
+     * ԴΰΧ
+     * ڲڵ㱣İΧϢʱӸڵ
+     * ÿһ㰴ӽڵҪ֮ѡO(log L)ѡһԴ
+     * ¼ÿԴӸڵ·ڹ߻йԴʱͬѡ
+     */
+    class LightBVH
+    {
+    private:
+        /**
+         * ڵ㣬һӽڵڸڵ֮
+         */
+        struct Node
+        {
+            LightBounds bounds;
+            unsigned int childOrLight;  // ڲڵΪڶӽڵ±꣬ҶڵΪԴ±
+            bool leaf;
+        };
+
+        vector<Node> nodes;
+        vector<uint64_t> bitTrails;     // ÿԴӸڵ·iλʾiǷߵڶӽڵ
+
+        /**
+         * ݹ鹹
+         * @param bounds ȫԴİΧϢ
+         * @param lights Դ±
+         * @param begin ʼλ
+         * @param end λã
+         * @param bitTrail ǰڵ·
+         * @param depth ǰڵ
+         * @return ڵ±
+         */
+        unsigned int build(const vector<LightBounds>& bounds, vector<unsigned int>& lights,
+            unsigned int begin, unsigned int end, uint64_t bitTrail, unsigned int depth);
+
+    public:
+        LightBVH() = default;
+
+        /**
+         * 캯
+         * @param areaLights Դ
+         */
+        explicit LightBVH(const vector<AreaLight>& areaLights);
+
+        /**
+         * ҪѡһԴ
+         * @param p ɫ
+         * @param n ɫ㷨
+         * @param u [0,1)ڵ
+         * @param pmf ѡйԴĸ
+         * @return Դ±꣬йԴйʱ-1
+         */
+        int sample(const Vec3& p, const Vec3& n, float u, float& pmf) const;
+
+        /**
+         * ɫѡиԴĸ
+         * @param p ɫ
+         * @param n ɫ㷨
+         * @param light Դ±
+         * @return 
+         */
+        float pmf(const Vec3& p, const Vec3& n, unsigned int light) const;
+    };
+}
+
+#endif
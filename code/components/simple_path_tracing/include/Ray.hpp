@@ -20,6 +20,7 @@ namespace SimplePathTracer
     {
         Vec3 origin;        // 
         Vec3 direction;     // ߷򣨱Ϊλ
+        float coneSpread;   // ߸һصŽǣȣʱݴ˶ȡͼԤ˲
 
         /**
          * ù
@@ -55,6 +56,7 @@ namespace SimplePathTracer
         Ray(const Vec3& origin, const Vec3& direction)
             : origin                (origin)
             , direction             (direction)
+            , coneSpread            (0.f)
         {}
     
         /**
@@ -63,6 +65,7 @@ namespace SimplePathTracer
         Ray()
             : origin        {}
             , direction     {}
+            , coneSpread    (0.f)
         {}
     };
 }
@@ -3,18 +3,40 @@
 #define __SIMPLE_PATH_TRACER_HPP__
 
 #include "scene/Scene.hpp"
+#include "scene/GeometryFlattener.hpp"
+#include "server/Framebuffer.hpp"
+#include "geometry/SphericalRectangle.hpp"
 #include "Ray.hpp"
 #include "Camera.hpp"
 #include "intersections/HitRecord.hpp"
 
 #include "shaders/ShaderCreator.hpp"
+#include "TileScheduler.hpp"
+#include "Denoiser.hpp"
+#include "EnvironmentMap.hpp"
+#include "LightBVH.hpp"
 
 #include <tuple>
+#include <vector>
+#include <memory>
+#include <functional>
 namespace SimplePathTracer
 {
     using namespace NRenderer;
     using namespace std;
 
+    /**
+     * ߵһཻ
+     */
+    struct FirstHit
+    {
+        Vec3 albedo{0};         // ʣйԴʱΪضϵ[0,1]ķɫ
+        Vec3 normal{0};         // ߣδʱΪ0
+        float depth = 0;        // ཻ룬δʱΪ0
+        float materialId = -1;  // ±꣬δʱΪ-1
+        float primitiveId = -1; // ͼԪ±꣬δʱΪ-1
+    };
+
     /**
      * ·׷Ⱦ
      * ʵֻؿ巽·׷㷨
@@ -29,28 +51,72 @@ namespace SimplePathTracer
 
         unsigned int width;         // ͼ
         unsigned int height;        // ͼ߶
-        unsigned int depth;         // ݹ
-        unsigned int samples;       // ÿز
+        unsigned int depth;         // ·ȣӲޣ
+        unsigned int samples;       // ÿزʽȾĿ
+        bool progressive;           // Ƿ񽥽ʽȾ
+        unsigned int samplesPerPass;// ʽȾÿֵÿز
+        bool adaptive;              // ǷӦ
+        float adaptiveThreshold;    // Ӧֵ
+        unsigned int threads;       // Ⱦ߳0ʾʹӲ
+        SequenceType sequenceType;  // 
+        unsigned int seed;          // 
+        bool denoise;               // ȾǷ
+
+        constexpr static unsigned int russianRouletteDepth = 3;  // ӵڼηʼʹö˹̶
+        constexpr static unsigned int adaptiveBaseSamples = 16;  // ӦǰÿصĻ
+        constexpr static unsigned int tileSize = 16;             // Ӧжͼ߳أ
 
         using SCam = SimplePathTracer::Camera;
         SCam camera;                // 
 
         vector<SharedShader> shaderPrograms;  // ɫб
+        SharedFlatGeometry geometry;          // չļ
+        shared_ptr<const LightBVH> lightBVH;  // ԴĲΰΧУڰҪѡԴ
+        shared_ptr<const EnvironmentMap> environmentMap;  // ͼԴδʹûͼʱΪ
+
+        vector<Vec3> accumulation;  // ۻÿвķ֮
+        vector<float> luminanceSquared;       // ÿвȵƽͣڹƷ
+        vector<Vec3> albedoBuffer;            // ÿصһཻ֮
+        vector<Vec3> normalBuffer;            // ÿصһཻ֮
+        vector<float> depthBuffer;            // ÿصһཻ֮
+        vector<unsigned int> sampleCount;     // ÿʵɵĲ
+        vector<char> tileActive;              // ÿͼǷ
+        unsigned int tilesX;                  // ͼ
+        unsigned int accumulatedSamples;      // ۻÿɵĲӦʱΪδصĲ
+        function<bool()> stopRequested;       // ѯǷյǰ
+
+        Framebuffer framebuffer;              // ĸͨ
         
     public:
         /**
          * 캯
          * @param spScene ָ
+         * @param stopRequested ѯǷҪǰȾΪձʾ֧ж
          */
-        SimplePathTracerRenderer(SharedScene spScene)
+        SimplePathTracerRenderer(SharedScene spScene, function<bool()> stopRequested = nullptr)
             : spScene               (spScene)
             , scene                 (*spScene)
-            , camera                (spScene->camera)
+            , camera                (spScene->camera, spScene->renderOption.height)
+            , tilesX                (0)
+            , accumulatedSamples    (0)
+            , stopRequested         (stopRequested)
         {
             width = scene.renderOption.width;
             height = scene.renderOption.height;
             depth = scene.renderOption.depth;
             samples = scene.renderOption.samplesPerPixel;
+            progressive = scene.renderOption.progressive;
+            samplesPerPass = scene.renderOption.samplesPerPass;
+            adaptive = scene.renderOption.adaptiveSampling;
+            adaptiveThreshold = scene.renderOption.adaptiveThreshold;
+            threads = scene.renderOption.threads;
+            seed = scene.renderOption.seed;
+            denoise = scene.renderOption.denoise;
+            switch (scene.renderOption.sampler) {
+            case RenderOption::SamplerType::RANDOM: sequenceType = SequenceType::RANDOM; break;
+            case RenderOption::SamplerType::HALTON: sequenceType = SequenceType::HALTON; break;
+            default: sequenceType = SequenceType::SOBOL; break;
+            }
         }
         ~SimplePathTracerRenderer() = default;
 
@@ -68,16 +134,44 @@ namespace SimplePathTracer
          */
         void release(const RenderResult& r);
 
+        /**
+         * ȡȾ֡壨ɫAOVͨ
+         * @return ֡
+         */
+        const Framebuffer& getFramebuffer() const { return framebuffer; }
+
     private:
         /**
-         * Ⱦ񣨶̣߳
+         * Ⱦͼڶ߳еã
+         * @param tile ҪȾͼ
+         * @param passSamples ÿز
+         */
+        void renderTask(const Tile& tile, unsigned int passSamples);
+
+        /**
+         * ۻƽֵд֡ĸͨ
+         * ͼԪ±Ⱦʱֱд룬ڴ˴
+         */
+        void resolveFramebuffer();
+
+        /**
+         * ֡ɫͨдػGammaУ
          * @param pixels ػ
-         * @param width ͼ
-         * @param height ͼ߶
-         * @param off ʼƫ
-         * @param step 
          */
-        void renderTask(RGBA* pixels, int width, int height, int off, int step);
+        void resolve(RGBA* pixels);
+
+        /**
+         * صֵ׼ֵ֮ȣ
+         * @param index ±
+         * @return 
+         */
+        float pixelError(unsigned int index) const;
+
+        /**
+         * ͼ״̬ͼһֵʱͼ
+         * @return ͼ
+         */
+        unsigned int updateTiles();
 
         /**
          * GammaУ
@@ -87,12 +181,60 @@ namespace SimplePathTracer
         RGB gamma(const RGB& rgb);
         
         /**
-         * ·׷
-         * @param ray 
-         * @param currDepth ǰݹ
+         * ·׷ʵ֣˹̶ģ
+         * @param ray 
+         * @param firstHit һཻΪ
          * @return ɫ
          */
-        RGB trace(const Ray& ray, int currDepth);
+        RGB trace(const Ray& ray, FirstHit* firstHit = nullptr);
+
+        /**
+         * Դʽnext event estimation
+         * ڹԴϲһ㲢ӰߣBSDFpower heuristicҪԲ
+         * @param ray 
+         * @param hit ɫཻ¼
+         * @param shader ɫɫ
+         * @return ֱӹչ
+         */
+        RGB sampleAreaLight(const Ray& ray, const HitRecordBase& hit, const SharedShader& shader);
+
+        /**
+         * ͼʽ
+         * ͼȲ򲢷ӰߣBSDFpower heuristicҪԲ
+         * @param ray 
+         * @param hit ɫཻ¼
+         * @param shader ɫɫ
+         * @return չ
+         */
+        RGB sampleEnvironment(const Ray& ray, const HitRecordBase& hit, const SharedShader& shader);
+
+        /**
+         * ԴĸܶȣǶԴѡʣ
+         * @param light Դ±
+         * @param p ɫ
+         * @param n ɫ㷨
+         * @param direction ɫָԴĵλ
+         * @param distance ɫ㵽Դľ
+         * @return ܶȺֵ
+         */
+        float areaLightPdf(unsigned int light, const Vec3& p, const Vec3& n, const Vec3& direction, float distance) const;
+
+        /**
+         * жϹڸǷڵ
+         * @param r 
+         * @param distance 
+         * @return Ƿڵ
+         */
+        bool occluded(const Ray& r, float distance);
+
+        /**
+         * жϹڸǷһͼԪཻ
+         * @param r ߣͼԪͬһϵУ
+         * @param range ͼԪ
+         * @param distance 
+         * @return Ƿཻ
+         */
+        bool occludedInRange(const Ray& r, const FlatRange& range, float distance) const;
         
         /**
          * ཻ
@@ -100,13 +242,24 @@ namespace SimplePathTracer
          * @return ཻ¼
          */
         HitRecord closestHitObject(const Ray& r);
+
+        /**
+         * һͼԪвұclosestཻ
+         * @param r ߣͼԪͬһϵУ
+         * @param range ͼԪ
+         * @param primitiveBase һͼԪ±
+         * @param closest ǰ룬ҵཻʱ
+         * @param closestHit ǰཻ¼ҵཻʱ
+         * @return Ƿҵཻ
+         */
+        bool closestHitInRange(const Ray& r, const FlatRange& range, size_t primitiveBase, float& closest, HitRecord& closestHit) const;
         
         /**
          * ཻĹԴ
          * @param r 
-         * @return ཻͷǿ
+         * @return ཻ롢ǿȺ͹Դ
          */
-        tuple<float, Vec3> closestHitLight(const Ray& r);
+        tuple<float, Vec3, Handle> closestHitLight(const Ray& r);
     };
 }
 
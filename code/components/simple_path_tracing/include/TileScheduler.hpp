@@ -0,0 +1,124 @@
+#pragma once
+#ifndef __TILE_SCHEDULER_HPP__
+#define __TILE_SCHEDULER_HPP__
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+namespace SimplePathTracer
+{
+    using namespace std;
+
+    /**
+     * ͼ
+     * طΧΪ[x0, x1) x [y0, y1)yΪػеУ϶£
+     */
+    struct Tile
+    {
+        unsigned int index;         // ͼͼе±꣨ȣ
+        unsigned int x0, y0;        // ʼأ
+        unsigned int x1, y1;        // أ
+    };
+
+    /**
+     * ͼ
+     * ͼ񻮷Ϊ̶Сͼ鲢Hilbert
+     * ͼ鰴η̵ָ߳˫˶У̴߳Լеͷȡͼ飬
+     * ԼĶΪʱ̶߳еβȡ
+     * ߳ڵһrunʱפ֮ÿrunֻв
+     */
+    class TileScheduler
+    {
+    private:
+        /**
+         * ̵߳
+         */
+        struct WorkQueue
+        {
+            mutex m;
+            deque<unsigned int> tiles;  // ͼtilesе±
+        };
+
+        vector<Tile> tiles;         // Hilbertͼ
+        unsigned int tilesX;        // ͼ
+        unsigned int tilesY;        // ͼ
+
+        vector<WorkQueue> queues;   // ÿ߳һУ0ڵrun߳
+        vector<thread> workers;     // פ̣߳workers[i]ʹqueues[i + 1]
+        const function<void(const Tile&)>* task;    // ǰһִͼĺ
+        mutex poolMutex;
+        condition_variable startCondition;  // ֪ͨ߳̿ʼһ
+        condition_variable doneCondition;   // ֪ͨrun߳ȫɱ
+        unsigned int generation;    // ִαţÿrunһ
+        unsigned int running;       // δɵĹ߳
+        bool stopping;
+
+        /**
+         * ߳
+         * @param threadCount ߳ruṇ߳
+         */
+        void startWorkers(unsigned int threadCount);
+
+        /**
+         * ֪ͨ߳˳ȴ
+         */
+        void stopWorkers();
+
+        /**
+         * ߳ѭȴһֿʼͼֱжΪ
+         * @param id ߳ʹõĶ±
+         * @param seen ̴߳ʱִα
+         */
+        void workerLoop(unsigned int id, unsigned int seen);
+
+        /**
+         * ԼĶлȡͼ鴦ֱжΪ
+         * @param id ߳ʹõĶ±
+         */
+        void drain(unsigned int id);
+
+    public:
+        /**
+         * 캯
+         * @param width ͼ
+         * @param height ͼ߶
+         * @param tileSize ͼ߳أ
+         */
+        TileScheduler(unsigned int width, unsigned int height, unsigned int tileSize);
+
+        /**
+         * ߳
+         */
+        ~TileScheduler();
+
+        TileScheduler(const TileScheduler&) = delete;
+        TileScheduler& operator=(const TileScheduler&) = delete;
+
+        /**
+         * ʹö̴߳ȫͼ飬ʱͼѴ
+         * ߳һβͬʱ´߳
+         * @param threadCount ߳0ʾʹӲ
+         * @param task ͼĺᱻ̲߳
+         */
+        void run(unsigned int threadCount, const function<void(const Tile&)>& task);
+
+        /**
+         * ȡͼ
+         * @return ͼ
+         */
+        unsigned int size() const { return tilesX*tilesY; }
+
+        /**
+         * üʵʹõ߳
+         * @param threadCount õ߳0ʾʹӲ
+         * @return ʵ߳
+         */
+        static unsigned int resolveThreadCount(unsigned int threadCount);
+    };
+}
+
+#endif
\ No newline at end of file
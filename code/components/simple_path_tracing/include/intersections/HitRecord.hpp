@@ -21,6 +21,7 @@ namespace SimplePathTracer
         Vec3 hitPoint;     // ཻ
         Vec3 normal;       // ཻ㴦ķ
         Handle material;   // ཻĲʾ
+        unsigned int primitive = 0;  // ཻͼԪڳе±꣨Ϊ塢Ρƽ棩
     };
     
     // ʹoptionalװʾûཻ
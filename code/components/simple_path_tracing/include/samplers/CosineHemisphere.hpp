@@ -0,0 +1,41 @@
+#pragma once
+#ifndef __COSINE_HEMI_SPHERE_HPP__
+#define __COSINE_HEMI_SPHERE_HPP__
+
+#include "Sampler3d.hpp"
+
+namespace SimplePathTracer
+{
+    using namespace std;
+
+    /**
+     * ҼȨ
+     * zΪĵλϰ cos/ ĸܶɷ
+     * ʹMalleyڵλԲϾȲͶӰ
+     */
+    class CosineHemiSphere : public Sampler3d
+    {
+    private:
+        constexpr static float C_PI = 3.14159265358979323846264338327950288f;
+    public:
+        CosineHemiSphere() = default;
+
+        /**
+         * ҼȨֲİ
+         * zΪcosȣӦܶΪ z/
+         * @return άλ
+         */
+        Vec3 sample3d() override {
+            auto epsilon = next2d();
+            float epsilon1 = epsilon.x;
+            float epsilon2 = epsilon.y;
+            float r = sqrt(epsilon1);
+            float x = cos(2*C_PI*epsilon2) * r;
+            float y = sin(2*C_PI*epsilon2) * r;
+            float z = sqrt(max(0.f, 1 - epsilon1));
+            return { x, y, z };
+        }
+    };
+}
+
+#endif
\ No newline at end of file
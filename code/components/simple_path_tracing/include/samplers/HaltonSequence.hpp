@@ -0,0 +1,72 @@
+#pragma once
+#ifndef __HALTON_SEQUENCE_HPP__
+#define __HALTON_SEQUENCE_HPP__
+
+#include "SampleSequence.hpp"
+
+namespace SimplePathTracer
+{
+    /**
+     * Halton
+     * dάʹõdΪ׵ĸʽݣÿһλְӣάȣأλƽƣ
+     * ȱָάȵķֲԣʹ֮䲻
+     */
+    class HaltonSequence : public SampleSequence
+    {
+    private:
+        constexpr static uint32_t primeCount = 64;
+        constexpr static uint32_t primes[primeCount] = {
+              2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,  47,  53,
+             59,  61,  67,  71,  73,  79,  83,  89,  97, 101, 103, 107, 109, 113, 127, 131,
+            137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,
+            227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311
+        };
+
+        uint32_t seed;              // 
+
+        /**
+         * ŵĸʽ
+         * άȸõʹòͬļ
+         * @param dim ά
+         * @return [0,1)ڵֵ
+         */
+        float scrambledRadicalInverse(uint32_t dim) const {
+            uint32_t base = primes[dim % primeCount];
+            uint32_t digitSeed = hashCombine(hashCombine(seed, dim), pixel);
+            uint32_t a = index;
+            double invBase = 1.0 / double(base);
+            double invBaseM = 1.0;
+            double result = 0;
+            // ƽƶԸλ0ͬЧһֱչfloat
+            for (uint32_t level = 0; invBaseM > 1e-8; level++) {
+                uint32_t digit = a % base;
+                a /= base;
+                digit = (digit + hashCombine(digitSeed, level)) % base;
+                invBaseM *= invBase;
+                result += digit * invBaseM;
+            }
+            return std::min(float(result), 0x1.fffffep-1f);
+        }
+
+    public:
+        /**
+         * 캯
+         * @param seed 
+         */
+        HaltonSequence(uint32_t seed)
+            : seed              (seed)
+        {}
+
+        float get1d() override {
+            return scrambledRadicalInverse(dimension++);
+        }
+
+        Vec2 get2d() override {
+            float x = scrambledRadicalInverse(dimension++);
+            float y = scrambledRadicalInverse(dimension++);
+            return { x, y };
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -3,7 +3,6 @@
 #define __HEMI_SPHERE_HPP__
 
 #include "Sampler3d.hpp"
-#include <ctime>
 
 namespace SimplePathTracer
 {
@@ -12,18 +11,13 @@ namespace SimplePathTracer
     {
     private:
         constexpr static float C_PI = 3.14159265358979323846264338327950288f;
-        
-        default_random_engine e;
-        uniform_real_distribution<float> u;
     public:
-        HemiSphere()
-            : e               ((unsigned int)time(0) + insideSeed())
-            , u               (0, 1)
-        {}
+        HemiSphere() = default;
 
         Vec3 sample3d() override {
-            float epsilon1 = u(e);
-            float epsilon2 = u(e);
+            auto epsilon = next2d();
+            float epsilon1 = epsilon.x;
+            float epsilon2 = epsilon.y;
             float r = sqrt(1 - epsilon1 * epsilon1);
             float x = cos(2*C_PI*epsilon2) * r;
             float y = sin(2*C_PI*epsilon2) * r;
@@ -3,7 +3,6 @@
 #define __MARSAGLIA_HPP__
 
 #include "Sampler3d.hpp"
-#include <ctime>
 
 namespace SimplePathTracer
 {
@@ -12,41 +11,26 @@ namespace SimplePathTracer
     /**
      * Marsagliaȷֲ
      * ڵλɾȷֲ
-     * ʹMarsagliaܾͨڵλԲɵ㣬Ȼӳ䵽
+     * ԭMarsagliaľܾĲάȣƻͲеķֲ㣬
+     * ˸ֱֲ֮ͬӳ䣺z[-1,1]ϾȣλǾ
      */
     class Marsaglia : public Sampler3d
     {
     private:
-        default_random_engine e;                    // 
-        uniform_real_distribution<float> u;         // ȷֲ
-        
+        constexpr static float C_PI = 3.14159265358979323846264338327950288f;
     public:
-        /**
-         * 캯ʼ
-         */
-        Marsaglia()
-            : e               ((unsigned int)time(0) + insideSeed())
-            , u               (-1, 1)
-        {}
+        Marsaglia() = default;
 
         /**
          * ɵλϵľȷֲ
-         * ʹMarsagliaڵλԲڲȻӳ䵽
          * @return άλ
          */
         Vec3 sample3d() override {
-            float u_{0}, v_{0};
-            float r2{0};
-            do {
-                u_ = u(e);
-                v_ = u(e);
-                r2 = u_*u_ + v_*v_;
-            } while (r2 > 1);  // ܾȷڵλԲ
-            
-            // Marsaglia任Բڵӳ䵽
-            float x = 2 * u_ * sqrt(1 - r2);
-            float y = 2 * v_ * sqrt(1 - r2);
-            float z = 1 - 2 * r2;
+            auto epsilon = next2d();
+            float z = 1 - 2 * epsilon.x;
+            float r = sqrt(max(0.f, 1 - z*z));
+            float x = cos(2*C_PI*epsilon.y) * r;
+            float y = sin(2*C_PI*epsilon.y) * r;
             return { x, y, z };
         }
     };
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef __RANDOM_SEQUENCE_HPP__
+#define __RANDOM_SEQUENCE_HPP__
+
+#include "SampleSequence.hpp"
+
+namespace SimplePathTracer
+{
+    /**
+     * ڼĶ
+     * ״̬ÿɣӣأţάȣϣõ
+     * ˽߳ͼ˳޹أͬһܵõͬͼ
+     */
+    class RandomSequence : public SampleSequence
+    {
+    private:
+        uint32_t seed;              // 
+
+        /**
+         * ָάȵ
+         * @param dim ά
+         * @return [0,1)ڵ
+         */
+        float at(uint32_t dim) const {
+            uint32_t h = hashCombine(hashCombine(pcgHash(seed), pixel), index);
+            return toUnitFloat(hashCombine(h, dim));
+        }
+
+    public:
+        /**
+         * 캯
+         * @param seed 
+         */
+        RandomSequence(uint32_t seed)
+            : seed              (seed)
+        {}
+
+        float get1d() override {
+            return at(dimension++);
+        }
+
+        Vec2 get2d() override {
+            float x = at(dimension++);
+            float y = at(dimension++);
+            return { x, y };
+        }
+    };
+}
+
+#endif
\ No newline at end of file
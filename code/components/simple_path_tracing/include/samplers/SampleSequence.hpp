@@ -0,0 +1,83 @@
+#pragma once
+#ifndef __SAMPLE_SEQUENCE_HPP__
+#define __SAMPLE_SEQUENCE_HPP__
+
+#include <cstdint>
+#include <algorithm>
+#include "geometry/vec.hpp"
+
+namespace SimplePathTracer
+{
+    using NRenderer::Vec2;
+
+    /**
+     * л
+     * Ϊṩ[0,1)ڵľÿɣأţȷ
+     * ͬһÿȡһάȼһͲоݴ˱֤άڷֲ
+     */
+    class SampleSequence
+    {
+    protected:
+        uint32_t pixel = 0;         // ǰ±
+        uint32_t index = 0;         // ǰڵĲ
+        uint32_t dimension = 0;     // ǰʹõά
+
+    public:
+        virtual ~SampleSequence() = default;
+
+        /**
+         * ʼһµزάȴ0¼
+         * @param pixel ±
+         * @param index ڵĲ
+         */
+        void startPixelSample(uint32_t pixel, uint32_t index) {
+            this->pixel = pixel;
+            this->index = index;
+            this->dimension = 0;
+        }
+
+        /**
+         * ȡһάȵ
+         * @return [0,1)ڵ
+         */
+        virtual float get1d() = 0;
+
+        /**
+         * ȡάȵ
+         * @return [0,1)^2ڵ
+         */
+        virtual Vec2 get2d() = 0;
+    };
+
+    /**
+     * 32λϣPCGû
+     * @param v 
+     * @return ϣֵ
+     */
+    inline uint32_t pcgHash(uint32_t v) {
+        uint32_t state = v * 747796405u + 2891336453u;
+        uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+        return (word >> 22u) ^ word;
+    }
+
+    /**
+     * һֵеĹϣ
+     * @param seed еĹϣ
+     * @param v Ҫֵ
+     * @return µĹϣֵ
+     */
+    inline uint32_t hashCombine(uint32_t seed, uint32_t v) {
+        return pcgHash(seed ^ (v + 0x9e3779b9u + (seed << 6) + (seed >> 2)));
+    }
+
+    /**
+     * 32λӳ䵽[0,1)ڵĸ
+     * @param x 
+     * @return [0,1)ڵĸ
+     */
+    inline float toUnitFloat(uint32_t x) {
+        return std::min(float(x) * 0x1p-32f, 0x1.fffffep-1f);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -2,34 +2,110 @@
 #ifndef __SAMPLER_HPP__
 #define __SAMPLER_HPP__
 
-#include <mutex>
+#include <memory>
+
+#include "RandomSequence.hpp"
+#include "HaltonSequence.hpp"
+#include "SobolSequence.hpp"
 
 namespace SimplePathTracer
 {
-    using std::mutex;
+    /**
+     * 
+     */
+    enum class SequenceType
+    {
+        RANDOM, HALTON, SOBOL
+    };
     
     /**
      * 
      * ṩɵĻܣȷ̰߳ȫ
+     * вӵǰ̵߳Ĳȡ
+     * Ⱦ߳ÿزʼǰstartPixelSampleš
+     * б״ֻ̬ʱҪ
      */
     class Sampler
     {
+    private:
+        /**
+         * ֲ߳̾Ĳ
+         */
+        struct ThreadSequence
+        {
+            SequenceType type = SequenceType::RANDOM;
+            uint32_t seed = 0;
+            std::unique_ptr<SampleSequence> sequence;
+        };
+
+        static ThreadSequence& threadSequence() {
+            thread_local static ThreadSequence ts{};
+            return ts;
+        }
+
+        static std::unique_ptr<SampleSequence> createSequence(SequenceType type, uint32_t seed) {
+            switch (type) {
+            case SequenceType::HALTON:
+                return std::make_unique<HaltonSequence>(seed);
+            case SequenceType::SOBOL:
+                return std::make_unique<SobolSequence>(seed);
+            default:
+                return std::make_unique<RandomSequence>(seed);
+            }
+        }
+
     protected:
         /**
-         * ȡڲֵȷ̰߳ȫ
-         * @return ֵ
+         * ӵǰ̵߳Ĳȡһάȵ
+         * @return [0,1)ڵ
          */
-        static int insideSeed() {
-            static mutex m;
-            static int seed = 0;
-            m.lock();
-            seed++;
-            m.unlock();
-            return seed;
+        static float next1d() {
+            return sequence().get1d();
         }
+
+        /**
+         * ӵǰ̵߳Ĳȡάȵ
+         * @return [0,1)^2ڵ
+         */
+        static Vec2 next2d() {
+            return sequence().get2d();
+        }
+
     public:
         virtual ~Sampler() = default;
         Sampler() = default;
+
+        /**
+         * õǰ߳ʹõĲУӶʱ
+         * @param type 
+         * @param seed 
+         */
+        static void useSequence(SequenceType type, uint32_t seed) {
+            auto& ts = threadSequence();
+            if (ts.sequence && ts.type == type && ts.seed == seed) return;
+            ts.type = type;
+            ts.seed = seed;
+            ts.sequence = createSequence(type, seed);
+        }
+
+        /**
+         * ȡǰ̵߳Ĳ
+         * @return 
+         */
+        static SampleSequence& sequence() {
+            auto& ts = threadSequence();
+            if (!ts.sequence) ts.sequence = createSequence(ts.type, ts.seed);
+            return *ts.sequence;
+        }
+
+        /**
+         * ʼǰ̵߳һز
+         * @param pixel ±
+         * @param index ڵĲ
+         */
+        static void startPixelSample(uint32_t pixel, uint32_t index) {
+            sequence().startPixelSample(pixel, index);
+        }
     };
 }
 
@@ -3,6 +3,7 @@
 #define __SAMPLER_INSTANCE_HPP__
 
 #include "HemiSphere.hpp"
+#include "CosineHemisphere.hpp"
 #include "Marsaglia.hpp"
 #include "UniformSampler.hpp"
 #include "UniformInCircle.hpp"
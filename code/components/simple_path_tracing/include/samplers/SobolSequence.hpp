@@ -0,0 +1,101 @@
+#pragma once
+#ifndef __SOBOL_SEQUENCE_HPP__
+#define __SOBOL_SEQUENCE_HPP__
+
+#include "SampleSequence.hpp"
+
+namespace SimplePathTracer
+{
+    /**
+     * OwenŵSobol
+     * ÿάʹǰάSobol㣨(0,2)Уź궼ϣOwenţ
+     * ɣӣάȣأʹͬάȡ֮ͬ以ء
+     * 2ݸÿάͶӰ϶лķֲ㣬
+     * PMJ02ķֲͬ
+     */
+    class SobolSequence : public SampleSequence
+    {
+    private:
+        uint32_t seed;              // 
+
+        /**
+         * ת32λλ
+         */
+        static uint32_t reverseBits(uint32_t x) {
+            x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+            x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+            x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+            x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+            return (x >> 16) | (x << 16);
+        }
+
+        /**
+         * Laine-KarrasûֻõλӰλ
+         */
+        static uint32_t laineKarras(uint32_t x, uint32_t seed) {
+            x += seed;
+            x ^= x * 0x6c50b47cu;
+            x ^= x * 0xb82f1e52u;
+            x ^= x * 0xc7afe638u;
+            x ^= x * 0x8d22f6e6u;
+            return x;
+        }
+
+        /**
+         * ڹϣOwenţǶ׾û
+         */
+        static uint32_t owenScramble(uint32_t x, uint32_t seed) {
+            return reverseBits(laineKarras(reverseBits(x), seed));
+        }
+
+        /**
+         * ǰάSobol
+         * @param i 
+         * @param dim άȣ01
+         * @return 32λС
+         */
+        static uint32_t sobol(uint32_t i, uint32_t dim) {
+            if (dim == 0) return reverseBits(i);
+            uint32_t v = 1u << 31;
+            uint32_t result = 0;
+            for (; i; i >>= 1, v ^= v >> 1) {
+                if (i & 1) result ^= v;
+            }
+            return result;
+        }
+
+        /**
+         * ǰءά´ҺĲ
+         */
+        uint32_t shuffledIndex(uint32_t dimSeed) const {
+            return owenScramble(index, hashCombine(dimSeed, pixel));
+        }
+
+    public:
+        /**
+         * 캯
+         * @param seed 
+         */
+        SobolSequence(uint32_t seed)
+            : seed              (seed)
+        {}
+
+        float get1d() override {
+            uint32_t dimSeed = hashCombine(seed, dimension++);
+            uint32_t i = shuffledIndex(dimSeed);
+            return toUnitFloat(owenScramble(sobol(i, 0), hashCombine(dimSeed, ~pixel)));
+        }
+
+        Vec2 get2d() override {
+            uint32_t dimSeed = hashCombine(seed, dimension);
+            dimension += 2;
+            uint32_t i = shuffledIndex(dimSeed);
+            uint32_t pixelSeed = hashCombine(dimSeed, ~pixel);
+            float x = toUnitFloat(owenScramble(sobol(i, 0), pixelSeed));
+            float y = toUnitFloat(owenScramble(sobol(i, 1), hashCombine(pixelSeed, 1)));
+            return { x, y };
+        }
+    };
+}
+
+#endif
\ No newline at end of file
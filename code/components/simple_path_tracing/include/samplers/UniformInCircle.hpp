@@ -7,23 +7,20 @@
 namespace SimplePathTracer
 {
     using namespace std;
+    /**
+     * λԲھȷֲ
+     * ʹüӳ䣬ÿι̶ά
+     */
     class UniformInCircle : public Sampler2d
     {
     private:
-        default_random_engine e;
-        uniform_real_distribution<float> u;
+        constexpr static float C_PI = 3.14159265358979323846264338327950288f;
     public:
-        UniformInCircle()
-            : e               ((unsigned int)time(0) + insideSeed())
-            , u               (-1, 1)
-        {}
+        UniformInCircle() = default;
         Vec2 sample2d() override {
-            float x{0}, y{0};
-            do {
-                x = u(e);
-                y = u(e);
-            } while((x*2 + y*2) > 1);
-            return { x, y };
+            auto epsilon = next2d();
+            float r = sqrt(epsilon.x);
+            return { r * cos(2*C_PI*epsilon.y), r * sin(2*C_PI*epsilon.y) };
         }
     
     };
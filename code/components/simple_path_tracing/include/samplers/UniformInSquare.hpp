@@ -3,7 +3,6 @@
 #define __UNIFORM_IN_SQUARE_HPP__
 
 #include "Sampler2d.hpp"
-#include <ctime>
 
 namespace SimplePathTracer
 {
@@ -15,25 +14,16 @@ namespace SimplePathTracer
      */
     class UniformInSquare: public Sampler2d
     {
-    private:
-        default_random_engine e;                    // 
-        uniform_real_distribution<float> u;         // ȷֲ
-        
     public:
-        /**
-         * 캯ʼ
-         */
-        UniformInSquare()
-            : e               ((unsigned int)time(0) + insideSeed())
-            , u               (-1, 1)
-        {}
+        UniformInSquare() = default;
         
         /**
          * ڵľȷֲ
          * @return ά
          */
         Vec2 sample2d() override {
-            return {u(e), u(e)};
+            auto epsilon = next2d();
+            return {2*epsilon.x - 1, 2*epsilon.y - 1};
         }
     };
 }
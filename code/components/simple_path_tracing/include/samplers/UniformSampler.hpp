@@ -3,7 +3,6 @@
 #define __UNIFORM_SAMPLER_HPP__
 
 #include "Sampler1d.hpp"
-#include <ctime>
 
 namespace SimplePathTracer
 {
@@ -15,25 +14,15 @@ namespace SimplePathTracer
      */
     class UniformSampler : public Sampler1d
     {
-    private:
-        default_random_engine e;                    // 
-        uniform_real_distribution<float> u;         // ȷֲ
-        
     public:
-        /**
-         * 캯ʼ
-         */
-        UniformSampler()
-            : e                 ((unsigned int)time(0) + insideSeed())
-            , u                 (0, 1)
-        {}
+        UniformSampler() = default;
         
         /**
          * [0,1]ڵľȷֲ
          * @return 
          */
         float sample1d() override {
-            return u(e);
+            return next1d();
         }
     };
 }
@@ -32,6 +32,21 @@ namespace SimplePathTracer
          * @return ɢϢ
          */
         Scattered shade(const Ray& ray, const Vec3& hitPoint, const Vec3& normal) const;
+
+        /**
+         * Lambertian BRDFͬΪalbedo/УΪ0
+         */
+        Vec3 eval(const Vec3& in, const Vec3& out, const Vec3& normal) const;
+
+        /**
+         * ҼȨĸܶȣcos/
+         */
+        float pdf(const Vec3& in, const Vec3& out, const Vec3& normal) const;
+
+        /**
+         * ɫ
+         */
+        RGB getAlbedo() const;
     };
 }
 
@@ -44,6 +44,30 @@ namespace SimplePathTracer
          * @return ɢϢ
          */
         virtual Scattered shade(const Ray& ray, const Vec3& hitPoint, const Vec3& normal) const = 0;
+
+        /**
+         * 䡢䷽µBRDFֵ
+         * @param in ߷
+         * @param out ɢ䷽
+         * @param normal 
+         * @return BRDFֵ
+         */
+        virtual Vec3 eval(const Vec3& in, const Vec3& out, const Vec3& normal) const = 0;
+
+        /**
+         * shadeɢ䷽ĸܶȣǶ
+         * @param in ߷
+         * @param out ɢ䷽
+         * @param normal 
+         * @return ܶȺֵ
+         */
+        virtual float pdf(const Vec3& in, const Vec3& out, const Vec3& normal) const = 0;
+
+        /**
+         * ȡʵķʣڽȺ
+         * @return 
+         */
+        virtual RGB getAlbedo() const = 0;
     };
     SHARE(Shader);  // 干ָ
 }
@@ -21,14 +21,15 @@ namespace SimplePathTracer
          * @param spScene ָ
          */
         void render(SharedScene spScene) {
-            // ·׷Ⱦ
-            SimplePathTracerRenderer renderer{spScene};
+            // ·׷ȾʽȾʱӦUIֹͣ
+            SimplePathTracerRenderer renderer{spScene, [this]() { return isStopRequested(); }};
             
             // ִȾ
             auto renderResult = renderer.render();
             auto [ pixels, width, height ]  = renderResult;
             
-            // õĻ
+            // AOVͨõĻ
+            getServer().screen.setFramebuffer(renderer.getFramebuffer());
             getServer().screen.set(pixels, width, height);
             
             // ͷȾڴ
@@ -0,0 +1,112 @@
+#include "Denoiser.hpp"
+#include "TileScheduler.hpp"
+
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
+namespace SimplePathTracer
+{
+    // B3һάϵάΪ
+    static const float kernel[3] = { 3.f/8.f, 1.f/4.f, 1.f/16.f };
+
+    /**
+     * һA-Trous˲
+     * Ȩֻرڲѭûз֧ڱ
+     * @param in 
+     * @param out 
+     * @param guide ṩͨ֡
+     * @param stepSize 
+     * @param sigmaColor εɫȨس߶
+     * @param rowBegin ʼ
+     * @param rowEnd У
+     */
+    void Denoiser::filterRows(const vector<Vec3>& in, vector<Vec3>& out, const Framebuffer& guide,
+        int stepSize, float sigmaColor, unsigned int rowBegin, unsigned int rowEnd) const
+    {
+        using Channel = Framebuffer::Channel;
+        float invSigmaColor2 = 1.f / (sigmaColor*sigmaColor);
+        for (unsigned int y = rowBegin; y < rowEnd; y++) {
+            for (unsigned int x = 0; x < width; x++) {
+                unsigned int p = y*width + x;
+                Vec3 cp = in[p];
+                Vec3 np = guide.getVec3(Channel::NORMAL, p);
+                float zp = guide.get(Channel::DEPTH, p);
+                // ɫȽƽռУGammaһ
+                Vec3 sp = glm::sqrt(glm::max(cp, Vec3{0}));
+                // ݲ
+                float invDepthScale = 1.f / (options.sigmaDepth * std::max(zp, 1e-3f) * float(stepSize) + 1e-6f);
+
+                Vec3 sum{0};
+                float weightSum = 0;
+                for (int dy = -2; dy <= 2; dy++) {
+                    int qy = std::clamp(int(y) + dy*stepSize, 0, int(height) - 1);
+                    float ky = kernel[std::abs(dy)];
+                    for (int dx = -2; dx <= 2; dx++) {
+                        int qx = std::clamp(int(x) + dx*stepSize, 0, int(width) - 1);
+                        unsigned int q = qy*width + qx;
+                        Vec3 cq = in[q];
+
+                        Vec3 diff = sp - glm::sqrt(glm::max(cq, Vec3{0}));
+                        float wColor = std::exp(-glm::dot(diff, diff) * invSigmaColor2);
+                        float zq = guide.get(Channel::DEPTH, q);
+                        float wNormal = std::pow(std::max(0.f, glm::dot(np, guide.getVec3(Channel::NORMAL, q))), options.sigmaNormal);
+                        float wDepth = std::exp(-std::abs(zp - zq) * invDepthScale);
+                        // δطΪ0ֻͬδеػ
+                        float bothMiss = float(zp == 0.f && zq == 0.f);
+                        // زܱԵԼ֤ȨغΪ
+                        float centre = float(dx == 0 && dy == 0);
+
+                        float w = ky * kernel[std::abs(dx)] * std::max(wColor * std::max(wNormal * wDepth, bothMiss), centre);
+                        sum += cq * w;
+                        weightSum += w;
+                    }
+                }
+                // صȨΪky*kxweightSumΪ0
+                out[p] = sum / weightSum;
+            }
+        }
+    }
+
+    /**
+     * 
+     * ÿεаͼָ߳
+     * @param framebuffer ֡
+     */
+    void Denoiser::denoise(Framebuffer& framebuffer) const
+    {
+        using Channel = Framebuffer::Channel;
+        unsigned int size = width*height;
+        if (size == 0) return;
+
+        // ÷ȥƣֻԹս
+        constexpr float albedoEpsilon = 1e-3f;
+        vector<Vec3> ping(size), pong(size);
+        for (unsigned int i = 0; i < size; i++) {
+            ping[i] = framebuffer.getVec3(Channel::BEAUTY, i) / glm::max(framebuffer.getVec3(Channel::ALBEDO, i), Vec3{albedoEpsilon});
+        }
+
+        unsigned int taskNums = std::min(TileScheduler::resolveThreadCount(threads), height);
+        float sigmaColor = options.sigmaColor;
+        for (unsigned int it = 0; it < options.iterations; it++) {
+            int stepSize = 1 << it;
+            vector<thread> workers;
+            for (unsigned int t = 0; t < taskNums; t++) {
+                unsigned int rowBegin = height*t / taskNums;
+                unsigned int rowEnd = height*(t + 1) / taskNums;
+                workers.emplace_back(&Denoiser::filterRows, this, cref(ping), ref(pong),
+                    cref(framebuffer), stepSize, sigmaColor, rowBegin, rowEnd);
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+            swap(ping, pong);
+            sigmaColor *= 0.5f;
+        }
+
+        // ˻ط
+        for (unsigned int i = 0; i < size; i++) {
+            framebuffer.set(Channel::BEAUTY, i, ping[i] * glm::max(framebuffer.getVec3(Channel::ALBEDO, i), Vec3{albedoEpsilon}));
+        }
+    }
+}
\ No newline at end of file
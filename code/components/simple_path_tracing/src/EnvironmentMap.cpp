@@ -0,0 +1,112 @@
+#include "EnvironmentMap.hpp"
+
+#include <cmath>
+
+namespace SimplePathTracer
+{
+    constexpr static float ENV_PI = 3.14159265358979323846f;
+
+    /**
+     * תΪͼ
+     * @param direction λ
+     * @return [0,1)^2ڵͼ꣬uӦλǣvӦ춥
+     */
+    static Vec2 directionToUv(const Vec3& direction) {
+        float theta = acos(glm::clamp(direction.y, -1.f, 1.f));
+        float phi = atan2(direction.z, direction.x);
+        if (phi < 0) phi += 2*ENV_PI;
+        return { phi / (2*ENV_PI), theta / ENV_PI };
+    }
+
+    /**
+     * 캯
+     * еȨسsinȣγӳѹ
+     * @param texture ͼ
+     */
+    EnvironmentMap::EnvironmentMap(const Texture& texture)
+        : texture               (texture)
+    {
+        unsigned int w = texture.width;
+        unsigned int h = texture.height;
+        vector<float> rowWeights(h, 0.f);
+        conditional.reserve(h);
+        for (unsigned int y = 0; y < h; y++) {
+            float sinTheta = sin(ENV_PI * (float(y) + 0.5f) / float(h));
+            vector<float> row(w);
+            for (unsigned int x = 0; x < w; x++) {
+                RGB c = texel(x, y);
+                row[x] = (0.2126f*c.r + 0.7152f*c.g + 0.0722f*c.b) * sinTheta;
+            }
+            conditional.emplace_back(row);
+            rowWeights[y] = conditional.back().getIntegral();
+        }
+        marginal = AliasTable{rowWeights};
+    }
+
+    RGB EnvironmentMap::texel(unsigned int x, unsigned int y) const {
+        auto c = texture.texel(0, x, y);
+        return { c.r, c.g, c.b };
+    }
+
+    /**
+     * ѯϵĻ
+     * ׶ŽǲһصĽǶʱڵ0ֲһ£
+     * ŽؽǶ֮ѡ񼶱Բ
+     * @param direction λ
+     * @param coneSpread ׶Ž
+     * @return 
+     */
+    RGB EnvironmentMap::eval(const Vec3& direction, float coneSpread) const {
+        if (texture.width == 0 || texture.height == 0) return RGB{0};
+        auto uv = directionToUv(direction);
+        float texelAngle = ENV_PI / float(texture.height);
+        if (coneSpread > texelAngle && texture.levels() > 1) {
+            RGBA c = texture.sample(uv, log2(coneSpread / texelAngle));
+            return { c.r, c.g, c.b };
+        }
+        unsigned int x = min(unsigned(uv.x * float(texture.width)), texture.width - 1);
+        unsigned int y = min(unsigned(uv.y * float(texture.height)), texture.height - 1);
+        return texel(x, y);
+    }
+
+    /**
+     * ͼȲһ
+     * ͼĸܶȻ㵽ǣp() = p(u,v) / (2^2 sin)
+     * @param u [0,1)^2ڵ
+     * @param direction λ
+     * @param pdf Ƕĸܶ
+     * @return ÷ķ
+     */
+    RGB EnvironmentMap::sample(const Vec2& u, Vec3& direction, float& pdf) const {
+        pdf = 0;
+        if (marginal.getIntegral() <= 0) return RGB{0};
+
+        float pdfV, pdfU;
+        unsigned int row, col;
+        float v = marginal.sample(u.y, pdfV, row);
+        float uu = conditional[row].sample(u.x, pdfU, col);
+
+        float theta = v * ENV_PI;
+        float phi = uu * 2*ENV_PI;
+        float sinTheta = sin(theta);
+        if (sinTheta <= 0) return RGB{0};
+        direction = { sinTheta*cos(phi), cos(theta), sinTheta*sin(phi) };
+        pdf = pdfV * pdfU / (2*ENV_PI*ENV_PI*sinTheta);
+        return texel(col, row);
+    }
+
+    /**
+     * ĸܶ
+     * @param direction λ
+     * @return ܶ
+     */
+    float EnvironmentMap::pdf(const Vec3& direction) const {
+        if (marginal.getIntegral() <= 0) return 0.f;
+        auto uv = directionToUv(direction);
+        float sinTheta = sin(uv.y * ENV_PI);
+        if (sinTheta <= 0) return 0.f;
+        unsigned int x = min(unsigned(uv.x * float(texture.width)), texture.width - 1);
+        unsigned int y = min(unsigned(uv.y * float(texture.height)), texture.height - 1);
+        return marginal.pdf(y) * conditional[y].pdf(x) / (2*ENV_PI*ENV_PI*sinTheta);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "LightBVH.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace SimplePathTracer
+{
+    constexpr static float LIGHT_PI = 3.14159265358979323846f;
+
+    static float safeSqrt(float x) {
+        return sqrt(std::max(x, 0.f));
+    }
+
+    // cos(max(0, a - b))
+    static float cosSubClamped(float sinA, float cosA, float sinB, float cosB) {
+        if (cosA > cosB) return 1.f;
+        return cosA*cosB + sinA*sinB;
+    }
+
+    // sin(max(0, a - b))
+    static float sinSubClamped(float sinA, float cosA, float sinB, float cosB) {
+        if (cosA > cosB) return 0.f;
+        return sinA*cosB - cosA*sinB;
+    }
+
+    float LightBounds::importance(const Vec3& p, const Vec3& n) const {
+        if (power <= 0) return 0.f;
+        Vec3 center = (min + max) * 0.5f;
+        Vec3 toPoint = p - center;
+        float d2 = glm::dot(toPoint, toPoint);
+        // ȡΧа뾶ɫڰΧڲʱҪԹ
+        float radius2 = glm::dot(max - min, max - min) * 0.25f;
+        d2 = std::max(d2, sqrt(radius2));
+
+        // ΧɫŵĽǶ
+        float cosThetaB, sinThetaB;
+        if (glm::dot(toPoint, toPoint) < radius2) {
+            cosThetaB = -1.f;
+            sinThetaB = 0.f;
+        }
+        else {
+            float sin2 = radius2 / glm::dot(toPoint, toPoint);
+            cosThetaB = safeSqrt(1.f - sin2);
+            sinThetaB = sqrt(sin2);
+        }
+
+        // ָⷽɫ㷽Сн
+        Vec3 wi = glm::normalize(toPoint);
+        float cosThetaW = glm::dot(axis, wi);
+        if (twoSided) cosThetaW = fabs(cosThetaW);
+        float sinThetaW = safeSqrt(1.f - cosThetaW*cosThetaW);
+        float sinThetaO = safeSqrt(1.f - cosThetaO*cosThetaO);
+        float cosThetaX = cosSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+        float sinThetaX = sinSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+        float cosThetaP = cosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+        if (cosThetaP <= cosThetaE) return 0.f;
+
+        float result = power * cosThetaP / d2;
+
+        // ɫ㷨䷽СнǣԴλڱ·ʱûй
+        if (n != Vec3{0}) {
+            float cosThetaI = glm::dot(-wi, n);
+            float sinThetaI = safeSqrt(1.f - cosThetaI*cosThetaI);
+            float cosThetaIP = cosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+            if (cosThetaIP <= 0) return 0.f;
+            result *= cosThetaIP;
+        }
+        return std::max(result, 0.f);
+    }
+
+    LightBounds LightBounds::merge(const LightBounds& a, const LightBounds& b) {
+        if (a.power <= 0) return b;
+        if (b.power <= 0) return a;
+
+        LightBounds r;
+        r.min = glm::min(a.min, b.min);
+        r.max = glm::max(a.max, b.max);
+        r.power = a.power + b.power;
+        r.twoSided = a.twoSided || b.twoSided;
+        r.cosThetaE = std::min(a.cosThetaE, b.cosThetaE);
+
+        // ϲ׶õߵС׶
+        float thetaA = acos(glm::clamp(a.cosThetaO, -1.f, 1.f));
+        float thetaB = acos(glm::clamp(b.cosThetaO, -1.f, 1.f));
+        const LightBounds* wide = thetaA >= thetaB ? &a : &b;
+        const LightBounds* narrow = thetaA >= thetaB ? &b : &a;
+        float thetaWide = std::max(thetaA, thetaB);
+        float thetaNarrow = std::min(thetaA, thetaB);
+        float thetaD = acos(glm::clamp(glm::dot(wide->axis, narrow->axis), -1.f, 1.f));
+        if (std::min(thetaD + thetaNarrow, LIGHT_PI) <= thetaWide) {
+            r.axis = wide->axis;
+            r.cosThetaO = wide->cosThetaO;
+            return r;
+        }
+        float thetaO = (thetaWide + thetaD + thetaNarrow) * 0.5f;
+        if (thetaO >= LIGHT_PI) {
+            r.axis = wide->axis;
+            r.cosThetaO = -1.f;
+            return r;
+        }
+        // ѿ׶խ׶תthetaO - thetaWide
+        float thetaR = thetaO - thetaWide;
+        Vec3 wr = glm::cross(wide->axis, narrow->axis);
+        if (glm::dot(wr, wr) < 1e-12f) {
+            r.axis = wide->axis;
+            r.cosThetaO = -1.f;
+            return r;
+        }
+        wr = glm::normalize(wr);
+        Vec3 w = wide->axis;
+        r.axis = glm::normalize(w*cos(thetaR) + glm::cross(wr, w)*sin(thetaR) + wr*glm::dot(wr, w)*(1.f - cos(thetaR)));
+        r.cosThetaO = cos(thetaO);
+        return r;
+    }
+
+    /**
+     * 캯
+     * ԴΪ˫淢ƽıΣȡȳ2
+     * @param areaLights Դ
+     */
+    LightBVH::LightBVH(const vector<AreaLight>& areaLights) {
+        auto n = unsigned(areaLights.size());
+        if (n == 0) return;
+
+        vector<LightBounds> bounds(n);
+        for (unsigned int i = 0; i < n; i++) {
+            auto& a = areaLights[i];
+            auto& b = bounds[i];
+            Vec3 corners[4] = { a.position, a.position + a.u, a.position + a.v, a.position + a.u + a.v };
+            for (auto& c : corners) {
+                b.min = glm::min(b.min, c);
+                b.max = glm::max(b.max, c);
+            }
+            Vec3 normal = glm::cross(a.u, a.v);
+            float area = glm::length(normal);
+            b.axis = area > 0 ? normal / area : Vec3{0, 0, 1};
+            b.cosThetaO = 1.f;
+            b.cosThetaE = 0.f;
+            b.twoSided = true;
+            float luminance = 0.2126f*a.radiance.r + 0.7152f*a.radiance.g + 0.0722f*a.radiance.b;
+            b.power = std::max(luminance, 0.f) * area * 2.f * LIGHT_PI;
+        }
+
+        vector<unsigned int> lights(n);
+        for (unsigned int i = 0; i < n; i++) lights[i] = i;
+        bitTrails.assign(n, 0);
+        nodes.reserve(2*n - 1);
+        build(bounds, lights, 0, n, 0, 0);
+    }
+
+    /**
+     * ݹ鹹
+     * عԴķֲᰴλ֣Ϊlog2(L)·64λ¼
+     */
+    unsigned int LightBVH::build(const vector<LightBounds>& bounds, vector<unsigned int>& lights,
+        unsigned int begin, unsigned int end, uint64_t bitTrail, unsigned int depth)
+    {
+        unsigned int nodeIndex = unsigned(nodes.size());
+        nodes.push_back({});
+        if (end - begin == 1) {
+            auto light = lights[begin];
+            nodes[nodeIndex] = { bounds[light], light, true };
+            bitTrails[light] = bitTrail;
+            return nodeIndex;
+        }
+
+        Vec3 centroidMin{FLT_MAX}, centroidMax{-FLT_MAX};
+        for (unsigned int i = begin; i < end; i++) {
+            Vec3 c = (bounds[lights[i]].min + bounds[lights[i]].max) * 0.5f;
+            centroidMin = glm::min(centroidMin, c);
+            centroidMax = glm::max(centroidMax, c);
+        }
+        Vec3 extent = centroidMax - centroidMin;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        unsigned int mid = (begin + end) / 2;
+        nth_element(lights.begin() + begin, lights.begin() + mid, lights.begin() + end,
+            [&](unsigned int a, unsigned int b) {
+                return bounds[a].min[axis] + bounds[a].max[axis] < bounds[b].min[axis] + bounds[b].max[axis];
+            });
+
+        uint64_t bit = uint64_t(1) << depth;
+        build(bounds, lights, begin, mid, bitTrail, depth + 1);
+        unsigned int second = build(bounds, lights, mid, end, bitTrail | bit, depth + 1);
+
+        nodes[nodeIndex].bounds = LightBounds::merge(nodes[nodeIndex + 1].bounds, nodes[second].bounds);
+        nodes[nodeIndex].childOrLight = second;
+        nodes[nodeIndex].leaf = false;
+        return nodeIndex;
+    }
+
+    /**
+     * ҪѡһԴ
+     * ÿһ㰴ѡӳʹ
+     */
+    int LightBVH::sample(const Vec3& p, const Vec3& n, float u, float& pmf) const {
+        pmf = 0;
+        if (nodes.empty()) return -1;
+
+        float prob = 1.f;
+        unsigned int index = 0;
+        while (true) {
+            auto& node = nodes[index];
+            if (node.leaf) {
+                if (node.bounds.importance(p, n) <= 0) return -1;
+                pmf = prob;
+                return int(node.childOrLight);
+            }
+            float i0 = nodes[index + 1].bounds.importance(p, n);
+            float i1 = nodes[node.childOrLight].bounds.importance(p, n);
+            if (i0 <= 0 && i1 <= 0) return -1;
+            float p0 = i0 / (i0 + i1);
+            if (u < p0) {
+                index = index + 1;
+                u = std::min(u / p0, 0x1.fffffep-1f);
+                prob *= p0;
+            }
+            else {
+                index = node.childOrLight;
+                u = std::min((u - p0) / (1.f - p0), 0x1.fffffep-1f);
+                prob *= 1.f - p0;
+            }
+        }
+    }
+
+    /**
+     * ɫѡиԴĸ
+     * ظùԴ·ظʱѡ
+     */
+    float LightBVH::pmf(const Vec3& p, const Vec3& n, unsigned int light) const {
+        if (light >= bitTrails.size()) return 0.f;
+
+        uint64_t bitTrail = bitTrails[light];
+        float prob = 1.f;
+        unsigned int index = 0;
+        while (true) {
+            auto& node = nodes[index];
+            if (node.leaf) {
+                return node.bounds.importance(p, n) > 0 ? prob : 0.f;
+            }
+            float i0 = nodes[index + 1].bounds.importance(p, n);
+            float i1 = nodes[node.childOrLight].bounds.importance(p, n);
+            if (i0 <= 0 && i1 <= 0) return 0.f;
+            if (bitTrail & 1) {
+                prob *= i1 / (i0 + i1);
+                index = node.childOrLight;
+            }
+            else {
+                prob *= i0 / (i0 + i1);
+                index = index + 1;
+            }
+            bitTrail >>= 1;
+        }
+    }
+}
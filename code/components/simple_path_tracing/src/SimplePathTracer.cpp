@@ -2,13 +2,51 @@
 
 #include "SimplePathTracer.hpp"
 
-#include "VertexTransformer.hpp"
 #include "intersections/intersections.hpp"
 
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <mutex>
+
 namespace SimplePathTracer
 {
+    /**
+     * Ⱦõ
+     * ÿȾᴴµȾﰴ汾űϴιĽ
+     * Դδ޸ʱֱӸãȾõ޸Ĳᴥؽ
+     */
+    struct DerivedDataCache
+    {
+        mutex lock;
+        uint64_t lightVersion = 0;                          // lightBVHӦĹԴ汾
+        shared_ptr<const LightBVH> lightBVH;
+        uint64_t textureVersion = 0;                        // environmentMapӦ汾
+        size_t environmentIndex = 0;                        // environmentMapӦ±
+        shared_ptr<const EnvironmentMap> environmentMap;
+    };
+    static DerivedDataCache derivedDataCache;
+
+    /**
+     * ҪԲpower heuristic=2
+     * @param pdf ǰԵĸܶ
+     * @param otherPdf һֲԵĸܶ
+     * @return ǰԵȨ
+     */
+    static inline float powerHeuristic(float pdf, float otherPdf) {
+        float a = pdf*pdf;
+        float b = otherPdf*otherPdf;
+        return a + b > 0 ? a / (a + b) : 0.f;
+    }
+
+    /**
+     * ɫȣRec.709ϵ
+     * @param rgb ɫ
+     * @return 
+     */
+    static inline float luminance(const RGB& rgb) {
+        return 0.2126f*rgb.r + 0.7152f*rgb.g + 0.0722f*rgb.b;
+    }
+
     /**
      * GammaУ
      * ɫƽУģ۶ȵĸ֪
@@ -21,20 +59,27 @@ namespace SimplePathTracer
 
     /**
      * Ⱦ̣߳
-     * ָΧڵУ·׷ټ
-     * @param pixels ػ
-     * @param width ͼ
-     * @param height ͼ߶
-     * @param off ʼƫ
-     * @param step вڶ̷߳䣩
-     */
-    void SimplePathTracerRenderer::renderTask(RGBA* pixels, int width, int height, int off, int step) {
-        for(int i=off; i<height; i+=step) {  // 
-            for (int j=0; j<width; j++) {    // ÿе
+     * һͼڵأ·׷ټ㣬ۼӵۻ
+     * @param tile ҪȾͼ
+     * @param passSamples ÿز
+     */
+    void SimplePathTracerRenderer::renderTask(const Tile& tile, unsigned int passSamples) {
+        // ͼ
+        if (!tileActive[tile.index]) return;
+        Sampler::useSequence(sequenceType, seed);
+
+        for (unsigned int row=tile.y0; row<tile.y1; row++) {  // е
+            int i = height-row-1;            // ͼеУתy꣩
+            for (int j=tile.x0; j<tile.x1; j++) {  // ÿе
                 Vec3 color{0, 0, 0};         // ʼɫ
+                float lumSq = 0;             // ƽ
+                FirstHit features{};         // һཻ֮
+                auto index = row*width+j;
                 
                 // ز
-                for (int k=0; k < samples; k++) {
+                for (int k=0; k < passSamples; k++) {
+                    // ŽŸɵĲʹȾͬһͲм
+                    Sampler::startPixelSample(index, sampleCount[index] + k);
                     // 
                     auto r = defaultSamplerInstance<UniformInSquare>().sample2d();
                     float rx = r.x;
@@ -44,18 +89,111 @@ namespace SimplePathTracer
                     
                     // 
                     auto ray = camera.shoot(x, y);
-                    color += trace(ray, 0);  // ·׷
+                    FirstHit firstHit{};
+                    auto radiance = trace(ray, &firstHit);  // ·׷
+                    float lum = luminance(radiance);
+                    color += radiance;
+                    lumSq += lum*lum;
+                    features.albedo += firstHit.albedo;
+                    features.normal += firstHit.normal;
+                    features.depth += firstHit.depth;
+                    // ±겻ȡƽȡصĵһ
+                    if (sampleCount[index] == 0 && k == 0) {
+                        framebuffer.set(Framebuffer::Channel::MATERIAL_ID, index, firstHit.materialId);
+                        framebuffer.set(Framebuffer::Channel::PRIMITIVE_ID, index, firstHit.primitiveId);
+                    }
+                }
+                accumulation[index] += color;  // ۼӲ
+                luminanceSquared[index] += lumSq;
+                albedoBuffer[index] += features.albedo;
+                normalBuffer[index] += features.normal;
+                depthBuffer[index] += features.depth;
+                sampleCount[index] += passSamples;
+            }
+        }
+    }
+
+    /**
+     * ۻƽֵд֡
+     * ȡƽ¹һΪؾֵȷ
+     */
+    void SimplePathTracerRenderer::resolveFramebuffer() {
+        using Channel = Framebuffer::Channel;
+        for (unsigned int i = 0; i < width*height; i++) {
+            auto n = sampleCount[i];
+            float inv = n > 0 ? 1.f / float(n) : 0.f;
+            framebuffer.set(Channel::BEAUTY, i, accumulation[i] * inv);
+            framebuffer.set(Channel::ALBEDO, i, albedoBuffer[i] * inv);
+            float len = glm::length(normalBuffer[i]);
+            framebuffer.set(Channel::NORMAL, i, len > 0 ? normalBuffer[i] / len : Vec3{0});
+            framebuffer.set(Channel::DEPTH, i, depthBuffer[i] * inv);
+            framebuffer.set(Channel::SAMPLE_COUNT, i, float(n));
+            float variance = 0;
+            if (n > 1) {
+                float mean = luminance(accumulation[i]) * inv;
+                variance = max(luminanceSquared[i] * inv - mean*mean, 0.f) / float(n - 1);
+            }
+            framebuffer.set(Channel::VARIANCE, i, variance);
+        }
+    }
+
+    /**
+     * ֡ɫͨдػ
+     * @param pixels ػ
+     */
+    void SimplePathTracerRenderer::resolve(RGBA* pixels) {
+        for (unsigned int i = 0; i < width*height; i++) {
+            pixels[i] = {gamma(framebuffer.getVec3(Framebuffer::Channel::BEAUTY, i)), 1};  // GammaУ
+        }
+    }
+
+    /**
+     * ص
+     * ȵƾֵı׼ٳԾֵõ
+     * ֵСʱޱⰵϸ
+     * @param index ±
+     * @return 
+     */
+    float SimplePathTracerRenderer::pixelError(unsigned int index) const {
+        auto n = sampleCount[index];
+        if (n < 2) return FLOAT_INF;
+        float mean = luminance(accumulation[index]) / float(n);
+        float variance = (luminanceSquared[index] / float(n) - mean*mean) * float(n) / float(n - 1);
+        float standardError = sqrt(max(variance, 0.f) / float(n));
+        return standardError / max(mean, 1e-2f);
+    }
+
+    /**
+     * ͼ״̬
+     * ͼΪλжϣزߵ
+     * @return ͼ
+     */
+    unsigned int SimplePathTracerRenderer::updateTiles() {
+        unsigned int active = 0;
+        for (unsigned int t = 0; t < tileActive.size(); t++) {
+            if (!tileActive[t]) continue;
+            unsigned int x0 = (t % tilesX)*tileSize;
+            unsigned int y0 = (t / tilesX)*tileSize;
+            bool converged = true;
+            for (unsigned int y = y0; y < min(y0 + tileSize, height) && converged; y++) {
+                for (unsigned int x = x0; x < min(x0 + tileSize, width); x++) {
+                    if (pixelError(y*width + x) > adaptiveThreshold) {
+                        converged = false;
+                        break;
+                    }
                 }
-                color /= samples;  // ƽ
-                color = gamma(color);  // GammaУ
-                pixels[(height-i-1)*width+j] = {color, 1};  // 洢أתy꣩
             }
+            tileActive[t] = !converged;
+            if (!converged) active++;
         }
+        return active;
     }
 
     /**
      * Ⱦ
      * ʼɫִж߳ȾȾ
+     * ʽģʽÿֻۻ㻺ÿֽѵǰƽֵˢµĻ
+     * ﵽĿյֹͣʱ
      * @return Ⱦݡȡ߶ȣ
      */
     auto SimplePathTracerRenderer::render() -> RenderResult {
@@ -69,21 +207,99 @@ namespace SimplePathTracer
         // ػ
         RGBA* pixels = new RGBA[width*height]{};
 
-        // ֲת
-        VertexTransformer vertexTransformer{};
-        vertexTransformer.exec(spScene);
+        // 尴ģͱ任չ꣬޸
+        geometry = GeometryFlattener::get(scene, threads);
+
+        {
+            lock_guard<mutex> guard{derivedDataCache.lock};
+            auto& version = scene.version;
+            auto& cache = derivedDataCache;
+
+            // ԴĲΰΧУԴδ޸ʱ
+            if (!version.known() || !cache.lightBVH || cache.lightVersion != version.light) {
+                cache.lightBVH = make_shared<const LightBVH>(scene.areaLightBuffer);
+                cache.lightVersion = version.light;
+            }
+            lightBVH = cache.lightBVH;
+
+            // ͼҪԲֲδ޸ʱ
+            environmentMap.reset();
+            auto& ambient = scene.ambient;
+            if (ambient.type == Ambient::Type::ENVIROMENT_MAP && ambient.environmentMap.valid()
+                && ambient.environmentMap.index() < scene.textures.size()) {
+                auto index = ambient.environmentMap.index();
+                auto& texture = scene.textures[index];
+                if (!texture.empty()) {
+                    if (!version.known() || !cache.environmentMap
+                        || cache.textureVersion != version.texture || cache.environmentIndex != index) {
+                        cache.environmentMap = make_shared<const EnvironmentMap>(texture);
+                        cache.textureVersion = version.texture;
+                        cache.environmentIndex = index;
+                    }
+                    environmentMap = cache.environmentMap;
+                }
+            }
+        }
+
+        accumulation.assign(width*height, Vec3{0});
+        luminanceSquared.assign(width*height, 0.f);
+        albedoBuffer.assign(width*height, Vec3{0});
+        normalBuffer.assign(width*height, Vec3{0});
+        depthBuffer.assign(width*height, 0.f);
+        framebuffer = Framebuffer{width, height};
+        for (unsigned int c = 0; c < Framebuffer::channelCount; c++) {
+            framebuffer.add(Framebuffer::Channel(c));
+        }
+        sampleCount.assign(width*height, 0);
+        tilesX = (width + tileSize - 1) / tileSize;
+        TileScheduler scheduler{width, height, tileSize};
+        tileActive.assign(scheduler.size(), 1);
+        accumulatedSamples = 0;
+        getServer().logger.log("Rendering with " + to_string(TileScheduler::resolveThreadCount(threads)) + " threads");
+
+        // ǽʽģʽһȫӦʱÿһλ
+        unsigned int passSize = progressive ? max(samplesPerPass, 1u) : (adaptive ? adaptiveBaseSamples : samples);
 
-        // ߳Ⱦ
-        const auto taskNums = 8;  // ʹ8߳
-        thread t[taskNums];
-        for (int i=0; i < taskNums; i++) {
-            t[i] = thread(&SimplePathTracerRenderer::renderTask,
-                this, pixels, width, height, i, taskNums);
+        while (accumulatedSamples < samples) {
+            unsigned int passSamples = min(passSize, samples - accumulatedSamples);
+            // Ӧĵһɻ֤ƿɿ
+            if (adaptive && accumulatedSamples == 0) {
+                passSamples = min(max(passSamples, adaptiveBaseSamples), samples);
+            }
+
+            // ߳Ⱦͼ
+            scheduler.run(threads, [this, passSamples](const Tile& tile) {
+                renderTask(tile, passSamples);
+            });
+            accumulatedSamples += passSamples;
+
+            if (adaptive && accumulatedSamples < samples && updateTiles() == 0) {
+                break;  // ͼ鶼
+            }
+
+            if (progressive) {
+                // ˢµǰƽĻ
+                resolveFramebuffer();
+                resolve(pixels);
+                getServer().screen.set(pixels, width, height);
+                if (stopRequested && stopRequested()) {
+                    getServer().logger.warning("Stopped at " + to_string(accumulatedSamples) + " spp.");
+                    break;
+                }
+            }
+        }
+        resolveFramebuffer();
+        if (denoise) {
+            Denoiser denoiser{width, height, threads};
+            denoiser.denoise(framebuffer);
         }
-        for(int i=0; i < taskNums; i++) {
-            t[i].join();  // ȴ߳
+        resolve(pixels);
+        if (adaptive) {
+            unsigned long long total = 0;
+            for (auto n : sampleCount) total += n;
+            getServer().logger.log("Adaptive sampling: average " + to_string(float(total) / float(width*height)) + " spp");
         }
-        getServer().logger.log("Done...");
+        getServer().logger.log("Done... " + to_string(accumulatedSamples) + " spp");
         return {pixels, width, height};
     }
 
@@ -98,110 +314,340 @@ namespace SimplePathTracer
 
     /**
      * ҹཻ
-     * м壬ҵཻ
+     * ȱеͼԪٰѹ߱任ʵģͿռбģ͵ͼԪ
      * @param r 
      * @return ཻ¼
      */
     HitRecord SimplePathTracerRenderer::closestHitObject(const Ray& r) {
         HitRecord closestHit = nullopt;
         float closest = FLOAT_INF;
+        closestHitInRange(r, geometry->world, 0, closest, closestHit);
+        for (auto& instance : geometry->instances) {
+            // 򲻹һģͿռеtеt
+            Ray local = r;
+            local.origin = instance.localPoint(r.origin);
+            local.direction = instance.localDirection(r.direction);
+            if (closestHitInRange(local, instance.range, instance.primitiveBase, closest, closestHit)) {
+                closestHit->hitPoint = r.at(closestHit->t);
+                closestHit->normal = instance.worldNormal(closestHit->normal);
+            }
+        }
+        return closestHit; 
+    }
+
+    /**
+     * һͼԪвұclosestཻ
+     * @param r 
+     * @param range ͼԪ
+     * @param primitiveBase һͼԪ±꣬Ϊ塢Ρƽ
+     * @param closest ǰ
+     * @param closestHit ǰཻ¼
+     * @return Ƿҵཻ
+     */
+    bool SimplePathTracerRenderer::closestHitInRange(const Ray& r, const FlatRange& range, size_t primitiveBase,
+                                                     float& closest, HitRecord& closestHit) const {
+        bool found = false;
+        unsigned int primitive = unsigned(primitiveBase);
         
         // 
-        for (auto& s : scene.sphereBuffer) {
-            auto hitRecord = Intersection::xSphere(r, s, 0.000001, closest);
+        for (size_t i = range.sphereBegin; i < range.sphereEnd; i++, primitive++) {
+            auto hitRecord = Intersection::xSphere(r, geometry->spheres[i], 0.000001, closest);
             if (hitRecord && hitRecord->t < closest) {
                 closest = hitRecord->t;
                 closestHit = hitRecord;
+                closestHit->primitive = primitive;
+                found = true;
             }
         }
         
         // 
-        for (auto& t : scene.triangleBuffer) {
-            auto hitRecord = Intersection::xTriangle(r, t, 0.000001, closest);
+        for (size_t i = range.triangleBegin; i < range.triangleEnd; i++, primitive++) {
+            auto hitRecord = Intersection::xTriangle(r, geometry->triangles[i], 0.000001, closest);
             if (hitRecord && hitRecord->t < closest) {
                 closest = hitRecord->t;
                 closestHit = hitRecord;
+                closestHit->primitive = primitive;
+                found = true;
             }
         }
         
         // ƽ
-        for (auto& p : scene.planeBuffer) {
-            auto hitRecord = Intersection::xPlane(r, p, 0.000001, closest);
+        for (size_t i = range.planeBegin; i < range.planeEnd; i++, primitive++) {
+            auto hitRecord = Intersection::xPlane(r, geometry->planes[i], 0.000001, closest);
             if (hitRecord && hitRecord->t < closest) {
                 closest = hitRecord->t;
                 closestHit = hitRecord;
+                closestHit->primitive = primitive;
+                found = true;
             }
         }
-        return closestHit; 
+        return found;
     }
     
+    /**
+     * жϹڸǷڵ
+     * ֻҵһཻǰ
+     * @param r 
+     * @param distance 
+     * @return Ƿڵ
+     */
+    bool SimplePathTracerRenderer::occluded(const Ray& r, float distance) {
+        if (occludedInRange(r, geometry->world, distance)) return true;
+        for (auto& instance : geometry->instances) {
+            Ray local = r;
+            local.origin = instance.localPoint(r.origin);
+            local.direction = instance.localDirection(r.direction);
+            if (occludedInRange(local, instance.range, distance)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * жϹڸǷһͼԪཻ
+     * @param r 
+     * @param range ͼԪ
+     * @param distance 
+     * @return Ƿཻ
+     */
+    bool SimplePathTracerRenderer::occludedInRange(const Ray& r, const FlatRange& range, float distance) const {
+        for (size_t i = range.sphereBegin; i < range.sphereEnd; i++) {
+            if (Intersection::xSphere(r, geometry->spheres[i], 0.000001, distance)) return true;
+        }
+        for (size_t i = range.triangleBegin; i < range.triangleEnd; i++) {
+            if (Intersection::xTriangle(r, geometry->triangles[i], 0.000001, distance)) return true;
+        }
+        for (size_t i = range.planeBegin; i < range.planeEnd; i++) {
+            if (Intersection::xPlane(r, geometry->planes[i], 0.000001, distance)) return true;
+        }
+        return false;
+    }
+
     /**
      * ҹԴཻ
      * Դҵཻ
      * @param r 
-     * @return ཻͷǿ
+     * @return ཻ롢ǿȺ͹Դ
      */
-    tuple<float, Vec3> SimplePathTracerRenderer::closestHitLight(const Ray& r) {
+    tuple<float, Vec3, Handle> SimplePathTracerRenderer::closestHitLight(const Ray& r) {
         Vec3 v = {};
+        Handle light = {};
         HitRecord closest = getHitRecord(FLOAT_INF, {}, {}, {});
         
         // Դ
-        for (auto& a : scene.areaLightBuffer) {
+        for (unsigned int i = 0; i < scene.areaLightBuffer.size(); i++) {
+            auto& a = scene.areaLightBuffer[i];
             auto hitRecord = Intersection::xAreaLight(r, a, 0.000001, closest->t);
             if (hitRecord && closest->t > hitRecord->t) {
                 closest = hitRecord;
                 v = a.radiance;  // ¼ǿ
+                light = Handle(i);
             }
         }
-        return { closest->t, v };
+        return { closest->t, v, light };
+    }
+
+    /**
+     * Դĸܶ
+     * ԴϲǸܶȣsampleAreaLightʹͬһԣԹԴΰΧеѡ
+     * @param light Դ±
+     * @param p ɫ
+     * @param normal ɫ㷨
+     * @param direction ɫָԴĵλ
+     * @param distance ɫ㵽Դľ
+     * @return ܶȺֵ
+     */
+    float SimplePathTracerRenderer::areaLightPdf(unsigned int light, const Vec3& p, const Vec3& normal, const Vec3& direction, float distance) const {
+        auto& a = scene.areaLightBuffer[light];
+        float pdf = ParallelogramSampler{p, a.position, a.u, a.v}.pdf(direction, distance);
+        if (pdf <= 0) return 0.f;
+        return pdf * lightBVH->pmf(p, normal, light);
+    }
+
+    /**
+     * Դʽ
+     * ͨԴΰΧаҪѡһԴιԴھȲ
+     * бƽıιԴϾȲ
+     * ӰжϿɼԣpower heuristicBSDFϲ
+     * @param ray 
+     * @param hit ɫཻ¼
+     * @param shader ɫɫ
+     * @return ֱӹչ
+     */
+    RGB SimplePathTracerRenderer::sampleAreaLight(const Ray& ray, const HitRecordBase& hit, const SharedShader& shader) {
+        if (scene.areaLightBuffer.empty()) return Vec3{0};
+
+        auto& sampler = defaultSamplerInstance<UniformSampler>();
+        float selectPmf;
+        int index = lightBVH->sample(hit.hitPoint, hit.normal, sampler.sample1d(), selectPmf);
+        if (index < 0) return Vec3{0};
+        auto& a = scene.areaLightBuffer[index];
+
+        ParallelogramSampler lightSampler{hit.hitPoint, a.position, a.u, a.v};
+        float pointPdf;
+        float su = sampler.sample1d();
+        float sv = sampler.sample1d();
+        Vec3 lightPoint = lightSampler.sample({su, sv}, pointPdf);
+        if (pointPdf <= 0) return Vec3{0};
+        Vec3 toLight = lightPoint - hit.hitPoint;
+        float distance = glm::length(toLight);
+        if (distance <= 0) return Vec3{0};
+        Vec3 direction = toLight / distance;
+
+        float n_dot_in = glm::dot(hit.normal, direction);
+        if (n_dot_in <= 0) return Vec3{0};
+
+        // ѡڲʱõٱΰΧ
+        float lightPdf = selectPmf * pointPdf;
+        if (lightPdf <= 0) return Vec3{0};
+
+        // ӰߣԶڹԴԱԴƽཻ
+        if (occluded(Ray{hit.hitPoint, direction}, distance*(1.f - 0.0001f))) return Vec3{0};
+
+        auto f = shader->eval(ray.direction, direction, hit.normal);
+        float bsdfPdf = shader->pdf(ray.direction, direction, hit.normal);
+        float weight = powerHeuristic(lightPdf, bsdfPdf);
+
+        return a.radiance * f * n_dot_in * weight / lightPdf;
+    }
+
+    /**
+     * ͼʽ
+     * Ӱ߱Դסʱûй
+     * @param ray 
+     * @param hit ɫཻ¼
+     * @param shader ɫɫ
+     * @return չ
+     */
+    RGB SimplePathTracerRenderer::sampleEnvironment(const Ray& ray, const HitRecordBase& hit, const SharedShader& shader) {
+        Vec3 direction;
+        float envPdf;
+        auto u = defaultSamplerInstance<UniformInSquare>().sample2d();
+        RGB radiance = environmentMap->sample((u + 1.f)*0.5f, direction, envPdf);
+        if (envPdf <= 0) return Vec3{0};
+
+        float n_dot_in = glm::dot(hit.normal, direction);
+        if (n_dot_in <= 0) return Vec3{0};
+
+        Ray shadowRay{hit.hitPoint, direction};
+        if (occluded(shadowRay, FLOAT_INF)) return Vec3{0};
+        if (get<0>(closestHitLight(shadowRay)) != FLOAT_INF) return Vec3{0};
+
+        auto f = shader->eval(ray.direction, direction, hit.normal);
+        float bsdfPdf = shader->pdf(ray.direction, direction, hit.normal);
+        float weight = powerHeuristic(envPdf, bsdfPdf);
+
+        return radiance * f * n_dot_in * weight / envPdf;
     }
 
     /**
      * ·׷
-     * ʵؿ·׷㷨ݹɫ
-     * @param r 
-     * @param currDepth ǰݹ
+     * ѭݹʵؿ·׷٣·۳throughput
+     * ÿɫԴʽBSDFйԴʱMISȨؼ뷢
+     * ɴηʹö˹̶İǰֹ·depthΪӲ
+     * @param ray 
+     * @param firstHit һཻΪ
      * @return ɫ
      */
-    RGB SimplePathTracerRenderer::trace(const Ray& r, int currDepth) {
-        // ﵽݹȣػ
-        if (currDepth == depth) return scene.ambient.constant;
-        
-        // ͹Դཻ
-        auto hitObject = closestHitObject(r);
-        auto [ t, emitted ] = closestHitLight(r);
-        
-        // ߻
-        if (hitObject && hitObject->t < t) {
+    RGB SimplePathTracerRenderer::trace(const Ray& ray, FirstHit* firstHit) {
+        RGB radiance{0};        // ·ۼƵķ
+        Vec3 throughput{1};     // · BRDF*cos/pdf ĳ˻
+        Ray r = ray;
+        float bsdfPdf = 0.f;    // ɵǰߵBSDFܶȣΪ0ʾߣMIS
+        Vec3 prevNormal{0};     // ɵǰߵɫ㷨ߣڼԴѡ
+
+        for (unsigned int currDepth = 0; ; currDepth++) {
+            // ﵽȣۼӳ⣨ͼֻڹʱ룩
+            if (currDepth == depth) {
+                if (!environmentMap) radiance += throughput * scene.ambient.constant;
+                break;
+            }
+
+            // ͹Դཻ
+            auto hitObject = closestHitObject(r);
+            auto [ t, emitted, light ] = closestHitLight(r);
+
+            // ߻йԴֱۼӷ⣬BSDFʽԴMISȨ
+            if (!(hitObject && hitObject->t < t)) {
+                if (currDepth == 0 && firstHit && t != FLOAT_INF) {
+                    // ¼ԴһķߣʱͬһԴϵػ
+                    auto& a = scene.areaLightBuffer[light.index()];
+                    Vec3 n = glm::normalize(glm::cross(a.u, a.v));
+                    firstHit->albedo = glm::min(emitted, Vec3{1});
+                    firstHit->normal = glm::dot(n, r.direction) > 0 ? -n : n;
+                    firstHit->depth = t;
+                    firstHit->primitiveId = float(geometry->size() + light.index());
+                }
+                if (t != FLOAT_INF) {
+                    float weight = 1.f;
+                    if (bsdfPdf > 0) {
+                        float lightPdf = areaLightPdf(light.index(), r.origin, prevNormal, r.direction, t);
+                        weight = powerHeuristic(bsdfPdf, lightPdf);
+                    }
+                    radiance += throughput * emitted * weight;
+                }
+                else if (environmentMap) {
+                    // ݣ뻷ͼBSDF뻷ͼʽMISȨ
+                    float weight = 1.f;
+                    if (bsdfPdf > 0) {
+                        weight = powerHeuristic(bsdfPdf, environmentMap->pdf(r.direction));
+                    }
+                    // ֱֻݵ߰ŽǶȡԤ˲BSDFʽMIS
+                    // ֲԱͬһsamplepdfһȡ0
+                    float coneSpread = currDepth == 0 ? r.coneSpread : 0.f;
+                    radiance += throughput * environmentMap->eval(r.direction, coneSpread) * weight;
+                }
+                break;  // йԴδκ壬·
+            }
+
             auto mtlHandle = hitObject->material;
+            auto& shader = shaderPrograms[mtlHandle.index()];
+            if (currDepth == 0 && firstHit) {
+                firstHit->albedo = shader->getAlbedo();
+                firstHit->normal = hitObject->normal;
+                firstHit->depth = hitObject->t;
+                firstHit->materialId = float(mtlHandle.index());
+                firstHit->primitiveId = float(hitObject->primitive);
+            }
             // ʹòɫɢ
-            auto scattered = shaderPrograms[mtlHandle.index()]->shade(r, hitObject->hitPoint, hitObject->normal);
+            auto scattered = shader->shade(r, hitObject->hitPoint, hitObject->normal);
             auto scatteredRay = scattered.ray;
             auto attenuation = scattered.attenuation;
-            auto emitted = scattered.emitted;
-            
-            // ݹ׷ɢ
-            auto next = trace(scatteredRay, currDepth+1);
-            float n_dot_in = glm::dot(hitObject->normal, scatteredRay.direction);
             float pdf = scattered.pdf;
-            
+
+            radiance += throughput * scattered.emitted;
+
+            // ʽԴֻɢܻйԴڽУ
+            // ֤BSDFͬ·ռ䣬MISȨ֮Ϊ1
+            bool nee = currDepth + 1 < depth;
+            if (nee) {
+                radiance += throughput * sampleAreaLight(r, *hitObject, shader);
+                if (environmentMap) {
+                    radiance += throughput * sampleEnvironment(r, *hitObject, shader);
+                }
+            }
+
+            float n_dot_in = glm::dot(hitObject->normal, scatteredRay.direction);
+            if (pdf <= 0 || n_dot_in <= 0) break;
+
             /**
              * ·׷Ⱦʵ֣
-             * emitted      - Le(p, w_0) Է
-             * next         - Li(p, w_i) 
              * n_dot_in     - cos<n, w_i> 
              * attenuation  - BRDF ˫ֲ
              * pdf          - p(w) ܶȺ
              **/
-            return emitted + attenuation * next * n_dot_in / pdf;
-        }
-        // ߻йԴ
-        else if (t != FLOAT_INF) {
-            return emitted;
-        }
-        // δκ
-        else {
-            return Vec3{0};
+            throughput *= attenuation * n_dot_in / pdf;
+
+            // ˹̶ģΪʣ·Ըøʱƫ
+            if (currDepth + 1 >= russianRouletteDepth) {
+                float survival = std::min(std::max(throughput.x, std::max(throughput.y, throughput.z)), 0.95f);
+                if (defaultSamplerInstance<UniformSampler>().sample1d() >= survival) break;
+                throughput /= survival;
+            }
+
+            r = scatteredRay;
+            bsdfPdf = nee ? pdf : 0.f;
+            prevNormal = hitObject->normal;
         }
+        return radiance;
     }
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "TileScheduler.hpp"
+
+#include <thread>
+#include <algorithm>
+
+namespace SimplePathTracer
+{
+    /**
+     * HilbertϵľתΪ
+     * @param n ߳2ݣ
+     * @param d ϵľ
+     * @param x x
+     * @param y y
+     */
+    static void hilbertToXY(unsigned int n, unsigned int d, unsigned int& x, unsigned int& y) {
+        x = y = 0;
+        for (unsigned int s = 1; s < n; s *= 2) {
+            unsigned int rx = 1 & (d / 2);
+            unsigned int ry = 1 & (d ^ rx);
+            // ת
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = s - 1 - x;
+                    y = s - 1 - y;
+                }
+                swap(x, y);
+            }
+            x += s * rx;
+            y += s * ry;
+            d /= 4;
+        }
+    }
+
+    /**
+     * 캯
+     * Hilbert˳ͼ飬ڵͼڿռҲڣ
+     * ʹÿ̴߳ξнϺõķôֲ
+     * @param width ͼ
+     * @param height ͼ߶
+     * @param tileSize ͼ߳أ
+     */
+    TileScheduler::TileScheduler(unsigned int width, unsigned int height, unsigned int tileSize)
+        : task              (nullptr)
+        , generation        (0)
+        , running           (0)
+        , stopping          (false)
+    {
+        tilesX = (width + tileSize - 1) / tileSize;
+        tilesY = (height + tileSize - 1) / tileSize;
+
+        unsigned int n = 1;
+        while (n < tilesX || n < tilesY) n *= 2;
+
+        tiles.reserve(tilesX*tilesY);
+        for (unsigned int d = 0; d < n*n; d++) {
+            unsigned int tx, ty;
+            hilbertToXY(n, d, tx, ty);
+            if (tx >= tilesX || ty >= tilesY) continue;  // ͼΧͼ
+            tiles.push_back({
+                ty*tilesX + tx,
+                tx*tileSize, ty*tileSize,
+                min((tx + 1)*tileSize, width), min((ty + 1)*tileSize, height)
+            });
+        }
+    }
+
+    /**
+     * ߳
+     */
+    TileScheduler::~TileScheduler() {
+        stopWorkers();
+    }
+
+    /**
+     * üʵʹõ߳
+     * @param threadCount õ߳0ʾʹӲ
+     * @return ʵ߳
+     */
+    unsigned int TileScheduler::resolveThreadCount(unsigned int threadCount) {
+        if (threadCount == 0) threadCount = thread::hardware_concurrency();
+        return max(threadCount, 1u);
+    }
+
+    /**
+     * ʹö̴߳ȫͼ
+     * ʽȾÿֵһΣ߳ڸ֮临
+     * @param threadCount ߳0ʾʹӲ
+     * @param task ͼĺ
+     */
+    void TileScheduler::run(unsigned int threadCount, const function<void(const Tile&)>& task) {
+        if (tiles.empty()) return;
+        unsigned int taskNums = min(resolveThreadCount(threadCount), unsigned(tiles.size()));
+        if (taskNums != queues.size()) {
+            stopWorkers();
+            startWorkers(taskNums);
+        }
+
+        // ͼ鰴η߳
+        // ̴߳ʱڵȴһ֣пԲ
+        for (auto& q : queues) q.tiles.clear();
+        for (unsigned int i = 0; i < tiles.size(); i++) {
+            queues[size_t(i)*taskNums / tiles.size()].tiles.push_back(i);
+        }
+
+        {
+            lock_guard<mutex> lock{poolMutex};
+            this->task = &task;
+            running = unsigned(workers.size());
+            generation++;
+        }
+        startCondition.notify_all();
+        drain(0);  // ǰ߳ҲȾ
+        unique_lock<mutex> lock{poolMutex};
+        doneCondition.wait(lock, [this] { return running == 0; });
+        this->task = nullptr;
+    }
+
+    /**
+     * ߳
+     * @param threadCount ߳ruṇ߳
+     */
+    void TileScheduler::startWorkers(unsigned int threadCount) {
+        queues = vector<WorkQueue>(threadCount);
+        workers.reserve(threadCount - 1);
+        for (unsigned int i = 1; i < threadCount; i++) {
+            workers.emplace_back(&TileScheduler::workerLoop, this, i, generation);
+        }
+    }
+
+    /**
+     * ֪ͨ߳˳ȴ
+     */
+    void TileScheduler::stopWorkers() {
+        {
+            lock_guard<mutex> lock{poolMutex};
+            stopping = true;
+        }
+        startCondition.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+        workers.clear();
+        stopping = false;
+    }
+
+    /**
+     * ߳ѭ
+     * @param id ߳ʹõĶ±
+     * @param seen ̴߳ʱִαţֻ֮ʼִ
+     */
+    void TileScheduler::workerLoop(unsigned int id, unsigned int seen) {
+        while (true) {
+            {
+                unique_lock<mutex> lock{poolMutex};
+                startCondition.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            drain(id);
+            {
+                lock_guard<mutex> lock{poolMutex};
+                if (--running == 0) doneCondition.notify_one();
+            }
+        }
+    }
+
+    /**
+     * ͼֱжΪ
+     * @param id ߳ʹõĶ±
+     */
+    void TileScheduler::drain(unsigned int id) {
+        unsigned int taskNums = unsigned(queues.size());
+        while (true) {
+            bool found = false;
+            unsigned int next = 0;
+            // ȴԼеͷȡ
+            {
+                lock_guard<mutex> lock{queues[id].m};
+                if (!queues[id].tiles.empty()) {
+                    next = queues[id].tiles.front();
+                    queues[id].tiles.pop_front();
+                    found = true;
+                }
+            }
+            // ٴ̶߳еβȡ
+            for (unsigned int k = 1; k < taskNums && !found; k++) {
+                auto& victim = queues[(id + k) % taskNums];
+                lock_guard<mutex> lock{victim.m};
+                if (!victim.tiles.empty()) {
+                    next = victim.tiles.back();
+                    victim.tiles.pop_back();
+                    found = true;
+                }
+            }
+            // ڱֿʼǰȫӣжΪռʾ
+            if (!found) return;
+            (*task)(tiles[next]);
+        }
+    }
+}
\ No newline at end of file
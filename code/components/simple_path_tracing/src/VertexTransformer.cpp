@@ -1,42 +0,0 @@
-#include "VertexTransformer.hpp"
-#include "glm/gtc/matrix_transform.hpp"
-
-namespace SimplePathTracer
-{
-    /**
-     * ִж任
-     * мĶӾֲת
-     * @param spScene ָ
-     */
-    void VertexTransformer::exec(SharedScene spScene) {
-        auto& scene = *spScene;
-        
-        // гڵ
-        for (auto& node : scene.nodes) {
-            Mat4x4 t{1};  // ʼ任Ϊλ
-            auto& model = spScene->models[node.model];
-            
-            // ӦƽƱ任
-            t = glm::translate(t, model.translation);
-            
-            // ݼӦñ任
-            if (node.type == Node::Type::TRIANGLE) {
-                // 任ε
-                for (int i=0; i<3; i++) {
-                    auto& v = scene.triangleBuffer[node.entity].v[i];
-                    v = t*Vec4{v, 1};  // 任
-                }
-            }
-            else if (node.type == Node::Type::SPHERE) {
-                // 任λ
-                auto& v = scene.sphereBuffer[node.entity].position;
-                v = t*Vec4{v, 1};  // 任
-            }
-            else if (node.type == Node::Type::PLANE) {
-                // 任ƽλ
-                auto& v = scene.planeBuffer[node.entity].position;
-                v = t*Vec4{v, 1};  // 任
-            }
-        }
-    }
-}
\ No newline at end of file
@@ -21,7 +21,7 @@ namespace SimplePathTracer
     
     /**
      * Lambertianɢ
-     * ʵ䣬зϾɢ
+     * ʵ䣬ҼȨֲɢ䷽ҪԲ
      * @param ray 
      * @param hitPoint ཻ
      * @param normal 
@@ -30,15 +30,15 @@ namespace SimplePathTracer
     Scattered Lambertian::shade(const Ray& ray, const Vec3& hitPoint, const Vec3& normal) const {
         Vec3 origin = hitPoint;
         
-        // ڰھȲɢ䷽
-        Vec3 random = defaultSamplerInstance<HemiSphere>().sample3d();
+        // ڰڰҼȨɢ䷽
+        Vec3 random = defaultSamplerInstance<CosineHemiSphere>().sample3d();
         
         // ʹתԷΪzľֲϵ
         Onb onb{normal};
         Vec3 direction = glm::normalize(onb.local(random));
 
-        // LambertianɢĸܶȺ1/(2)
-        float pdf = 1/(2*PI);
+        // ҼȨĸܶȺcos/УֲϵcosȼΪz
+        float pdf = random.z/PI;
 
         // Lambertian BRDFalbedo/
         auto attenuation = albedo / PI;
@@ -50,4 +50,37 @@ namespace SimplePathTracer
             pdf                     // ܶȺֵ
         };
     }
+
+    /**
+     * Lambertian BRDFֵ
+     * @param in ߷
+     * @param out ɢ䷽
+     * @param normal 
+     * @return BRDFֵ
+     */
+    Vec3 Lambertian::eval(const Vec3& in, const Vec3& out, const Vec3& normal) const {
+        if (glm::dot(out, normal) <= 0) return Vec3{0};
+        return albedo / PI;
+    }
+
+    /**
+     * Lambertianĸܶ
+     * @param in ߷
+     * @param out ɢ䷽
+     * @param normal 
+     * @return ܶȺֵ
+     */
+    float Lambertian::pdf(const Vec3& in, const Vec3& out, const Vec3& normal) const {
+        float cosTheta = glm::dot(out, normal);
+        if (cosTheta <= 0) return 0.f;
+        return cosTheta/PI;
+    }
+
+    /**
+     * Lambertian
+     * @return ɫ
+     */
+    RGB Lambertian::getAlbedo() const {
+        return albedo;
+    }
 }
\ No newline at end of file
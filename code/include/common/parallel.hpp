@@ -0,0 +1,43 @@
+// 򵥵ݲй
+// ±ָʱ̴̣߳߳صһΣȫɺ󷵻
+#pragma once
+#ifndef __NR_PARALLEL_HPP__
+#define __NR_PARALLEL_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace NRenderer
+{
+    // 㴦countԪӦʹõ߳Ϊ1
+    // minPerThread: ÿ߳ٷֵԪԪ̫ʱ̵߳òʧ
+    // threads: ߳ޣ0ʾӲ߳
+    inline size_t parallelThreads(size_t count, size_t minPerThread, unsigned int threads = 0) {
+        if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+        return std::max<size_t>(1, std::min<size_t>(threads, count / std::max<size_t>(minPerThread, 1)));
+    }
+
+    // [0, count)ֶνִ߳Уfunc(begin, end)һΣֻһʱڵǰ߳
+    template<typename Func>
+    void parallelFor(size_t count, size_t minPerThread, unsigned int threads, Func&& func) {
+        size_t taskNums = parallelThreads(count, minPerThread, threads);
+        if (taskNums == 1) {
+            func(size_t(0), count);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(taskNums - 1);
+        for (size_t k = 1; k < taskNums; k++) {
+            workers.emplace_back([&func, begin = count*k/taskNums, end = count*(k + 1)/taskNums]() {
+                func(begin, end);
+            });
+        }
+        // һɵǰ̴߳
+        func(size_t(0), count/taskNums);
+        for (auto& w : workers) w.join();
+    }
+}
+
+#endif
\ No newline at end of file
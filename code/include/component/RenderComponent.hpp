@@ -8,6 +8,7 @@
 #include "scene/Scene.hpp"
 
 #include <functional>
+#include <atomic>
 
 namespace NRenderer
 {
@@ -19,12 +20,22 @@ namespace NRenderer
         // 麯Ⱦʵ
         // ʵִ˷Ⱦ߼
         virtual void render(SharedScene spScene) = 0;
+
+        // ֹͣ־UI߳ãȾ߳ѯ
+        atomic<bool> stopRequested{false};
     public:
         // ִȾ
         // onStart: ȾʼʱĻص
         // onFinish: ȾʱĻص
         // spScene: ҪȾĳ
         void exec(function<void()> onStart, function<void()> onFinish, SharedScene spScene);
+
+        // ǰȾ
+        // ȾÿһֽʽȾ鲢ǰصǰ
+        void requestStop();
+
+        // ǷյǰȾ
+        bool isStopRequested() const;
     };
 }
 
@@ -0,0 +1,137 @@
+// ƽıιԴǲ
+// ΰΣUrena et al. 2013ɫŵھȲ
+// бƽıǹСľ˻ΪȲ
+#pragma once
+#ifndef __NR_SPHERICAL_RECTANGLE_HPP__
+#define __NR_SPHERICAL_RECTANGLE_HPP__
+
+#include "geometry/vec.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace NRenderer
+{
+    // ƽıβ
+    // ͬһɫƽıΣܶȲѯʹͬһֲԣֱڶҪԲ
+    class ParallelogramSampler
+    {
+    private:
+        constexpr static float PI_F = 3.14159265358979323846f;
+        constexpr static float skewTolerance = 1e-3f;       // ߼нСڴֵʱΪ
+        constexpr static float minSolidAngle = 1e-4f;       // Сڴֵʱȶ
+
+        Vec3 p;             // ɫ
+        Vec3 corner;        // ƽıεһǵ
+        Vec3 u, v;          // 
+        float area;         // 
+        Vec3 normal;        // λ
+
+        // εľֲϵԤ
+        bool spherical;
+        Vec3 ex, ey, ez;
+        float x0, y0, x1, y1, z0;
+        float b0, b1, k;
+        float solidAngle;
+
+    public:
+        // p: ɫ
+        // corner: ƽıεһǵ
+        // u, v: 
+        ParallelogramSampler(const Vec3& p, const Vec3& corner, const Vec3& u, const Vec3& v)
+            : p                 (p)
+            , corner            (corner)
+            , u                 (u)
+            , v                 (v)
+            , spherical         (false)
+            , solidAngle        (0)
+        {
+            Vec3 n = glm::cross(u, v);
+            area = glm::length(n);
+            normal = area > 0 ? n / area : Vec3{0};
+
+            float ul = glm::length(u);
+            float vl = glm::length(v);
+            if (area <= 0 || fabs(glm::dot(u, v)) > skewTolerance * ul * vl) return;
+
+            ex = u / ul;
+            ey = v / vl;
+            ez = normal;
+            Vec3 d = corner - p;
+            z0 = glm::dot(d, ez);
+            // þλھֲϵz<0һ
+            if (z0 > 0) {
+                ez = -ez;
+                z0 = -z0;
+            }
+            if (z0 >= 0) return;
+            x0 = glm::dot(d, ex);
+            y0 = glm::dot(d, ey);
+            x1 = x0 + ul;
+            y1 = y0 + vl;
+
+            // ĸ㷽򹹳ɵıΣڴԲķ
+            Vec3 v00{x0, y0, z0}, v01{x0, y1, z0}, v10{x1, y0, z0}, v11{x1, y1, z0};
+            Vec3 n0 = glm::normalize(glm::cross(v00, v10));
+            Vec3 n1 = glm::normalize(glm::cross(v10, v11));
+            Vec3 n2 = glm::normalize(glm::cross(v11, v01));
+            Vec3 n3 = glm::normalize(glm::cross(v01, v00));
+            // ıεڽ
+            float g0 = acos(glm::clamp(-glm::dot(n0, n1), -1.f, 1.f));
+            float g1 = acos(glm::clamp(-glm::dot(n1, n2), -1.f, 1.f));
+            float g2 = acos(glm::clamp(-glm::dot(n2, n3), -1.f, 1.f));
+            float g3 = acos(glm::clamp(-glm::dot(n3, n0), -1.f, 1.f));
+            b0 = n0.z;
+            b1 = n2.z;
+            k = 2*PI_F - g2 - g3;
+            solidAngle = g0 + g1 - k;
+            spherical = solidAngle > minSolidAngle;
+        }
+
+        // Ƿǲ
+        bool isSolidAngleSampling() const { return spherical; }
+
+        // ƽıϵһ
+        // uv: [0,1)^2ڵ
+        // pdf: Ƕĸܶȣ޷ʱΪ0
+        // ز
+        Vec3 sample(const Vec2& uv, float& pdf) const {
+            if (!spherical) {
+                Vec3 point = corner + uv.x*u + uv.y*v;
+                Vec3 d = point - p;
+                float dist = glm::length(d);
+                pdf = dist > 0 ? this->pdf(d / dist, dist) : 0.f;
+                return point;
+            }
+
+            // ѡx
+            float au = uv.x * solidAngle + k;
+            float fu = (cos(au)*b0 - b1) / sin(au);
+            float cu = glm::clamp(copysign(1.f / sqrt(fu*fu + b0*b0), fu), -0.9999999f, 0.9999999f);
+            float xu = glm::clamp(-(cu*z0) / sqrt(std::max(1.f - cu*cu, 0.f)), x0, x1);
+            // ڸxֱ߶ϰѡy
+            float dd = sqrt(xu*xu + z0*z0);
+            float h0 = y0 / sqrt(dd*dd + y0*y0);
+            float h1 = y1 / sqrt(dd*dd + y1*y1);
+            float hv = h0 + uv.y*(h1 - h0);
+            float hv2 = hv*hv;
+            float yv = hv2 < 1.f - 1e-6f ? (hv*dd) / sqrt(1.f - hv2) : y1;
+
+            pdf = 1.f / solidAngle;
+            return p + xu*ex + yv*ey + z0*ez;
+        }
+
+        // ƽıһĸܶȣǶ
+        // direction: ɫĵλӦƽıཻ
+        // distance: ɫ㵽ľ
+        float pdf(const Vec3& direction, float distance) const {
+            if (spherical) return 1.f / solidAngle;
+            if (area <= 0) return 0.f;
+            // ˫棬Դཻжһ
+            float cosLight = fabs(glm::dot(normal, direction));
+            if (cosLight <= 0) return 0.f;
+            return distance*distance / (cosLight*area);
+        }
+    };
+} // namespace NRenderer
+
+#endif
@@ -0,0 +1,295 @@
+// չ
+// ѳڵļ尴ģ͵ı任決꣬д
+// ʵõģֻģͿռչһΣÿʵֻ任ʱѹ߱任ģͿռ
+#pragma once
+#ifndef __NR_GEOMETRY_FLATTENER_HPP__
+#define __NR_GEOMETRY_FLATTENER_HPP__
+
+#include "Scene.hpp"
+#include "common/parallel.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // ͼԪ䣬ֱspherestrianglesplanesе[begin, end)
+    struct FlatRange
+    {
+        size_t sphereBegin = 0, sphereEnd = 0;
+        size_t triangleBegin = 0, triangleEnd = 0;
+        size_t planeBegin = 0, planeEnd = 0;
+
+        size_t size() const {
+            return (sphereEnd - sphereBegin) + (triangleEnd - triangleBegin) + (planeEnd - planeBegin);
+        }
+    };
+
+    // ģʵģͿռеһͼԪֻ任
+    struct FlatInstance
+    {
+        FlatRange range;        // ģģͿռеͼԪ
+        Mat4x4 transform;       // ģͿռ䵽
+        Mat4x4 inverse;         // 굽ģͿռ
+        size_t primitiveBase;   // ʵһͼԪ±
+
+        // еĵ任ģͿռ
+        Vec3 localPoint(const Vec3& p) const {
+            return Vec3{inverse*Vec4{p, 1}};
+        }
+        // еķ任ģͿռ䣬һģͿռеĹ߲tͬ
+        Vec3 localDirection(const Vec3& d) const {
+            return Vec3{inverse*Vec4{d, 0}};
+        }
+        // ģͿռеķ߱任
+        Vec3 worldNormal(const Vec3& n) const {
+            return glm::normalize(glm::transpose(Mat3x3{inverse})*n);
+        }
+    };
+
+    // չļ
+    // ɼģ͵Ľڵ㰴ڵ˳չ꣬λڸ鿪ͷworld֮ǱʵõģģͿռеͼԪ
+    // չΪΣͼԪ±worldе塢Ρƽ棬֮ʵα
+    struct FlatGeometry
+    {
+        vector<Sphere> spheres;
+        vector<Triangle> triangles;
+        vector<Plane> planes;
+        FlatRange world;                // еͼԪ
+        vector<FlatInstance> instances; // ģʵ
+        size_t instancePrimitives = 0;  // ʵͼԪ֮
+
+        // ͼԪʵͼԪʵֱ
+        size_t size() const {
+            return world.size() + instancePrimitives;
+        }
+    };
+    using SharedFlatGeometry = shared_ptr<const FlatGeometry>;
+
+    // չ
+    // ޸ģͬһԶչļʰ汾Ż
+    class GeometryFlattener
+    {
+    public:
+        // չ
+        // threads: ߳0ʾʹӲ
+        static SharedFlatGeometry flatten(const Scene& scene, unsigned int threads = 0) {
+            auto& nodes = scene.nodes;
+
+            // չУ0ǿɼģ͵Ľڵ㣬ģ͵ı任չꣻ
+            // ֮ÿһʵõģͣڵģͿռֻչһΣʵ޹
+            vector<Job> jobs;
+            vector<size_t> groups{0};   // һ±
+            jobs.reserve(nodes.size());
+            for (auto& node : nodes) {
+                Transform t;
+                if (node.model < scene.models.size()) {
+                    auto& model = scene.models[node.model];
+                    if (!model.visible) continue;
+                    t = Transform{Mat3x3{model.scale.x, 0, 0,  0, model.scale.y, 0,  0, 0, model.scale.z}, model.translation};
+                }
+                jobs.push_back({&node, t});
+            }
+            groups.push_back(jobs.size());
+            vector<size_t> modelGroups(scene.models.size(), 0);   // ģģͿռչ飬0ʾδʵ
+            for (auto& instance : scene.instances) {
+                if (instance.model >= scene.models.size() || modelGroups[instance.model] != 0) continue;
+                for (auto nodeIndex : scene.models[instance.model].nodes) {
+                    if (nodeIndex < nodes.size()) jobs.push_back({&nodes[nodeIndex], Transform{}});
+                }
+                modelGroups[instance.model] = groups.size() - 1;
+                groups.push_back(jobs.size());
+            }
+            auto jobCount = jobs.size();
+
+            // һͳÿͼԪǰ׺͵õе㣬ͬʱ¸ͼԪ
+            // workǸͼԪǰ׺ͣڶ鰴ͼԪָ߳
+            vector<size_t> offsets(jobCount + 1, 0);
+            vector<size_t> work(jobCount + 1, 0);
+            vector<FlatRange> ranges(groups.size() - 1);
+            size_t sphereCount = 0, planeCount = 0;
+            for (size_t g = 0; g < ranges.size(); g++) {
+                auto& range = ranges[g];
+                range.sphereBegin = sphereCount;
+                range.triangleBegin = offsets[jobCount];
+                range.planeBegin = planeCount;
+                for (size_t i = groups[g]; i < groups[g + 1]; i++) {
+                    auto& node = *jobs[i].node;
+                    size_t triangles = 0;
+                    work[i + 1] = work[i] + 1;
+                    if (node.type == Node::Type::SPHERE) {
+                        offsets[i] = sphereCount++;
+                        continue;
+                    }
+                    if (node.type == Node::Type::PLANE) {
+                        offsets[i] = planeCount++;
+                        continue;
+                    }
+                    if (node.type == Node::Type::TRIANGLE) {
+                        triangles = 1;
+                    }
+                    else if (node.type == Node::Type::MESH && scene.meshBuffer[node.entity]) {
+                        triangles = scene.meshBuffer[node.entity]->positionIndices.size() / 3;
+                    }
+                    work[i + 1] = work[i] + triangles;
+                    offsets[i] = offsets[jobCount];
+                    offsets[jobCount] += triangles;
+                }
+                range.sphereEnd = sphereCount;
+                range.triangleEnd = offsets[jobCount];
+                range.planeEnd = planeCount;
+            }
+
+            auto geometry = make_shared<FlatGeometry>();
+            geometry->spheres.resize(sphereCount);
+            geometry->triangles.resize(offsets[jobCount]);
+            geometry->planes.resize(planeCount);
+
+            // ڶд뻥ص䣻ͼԪֶΣ
+            // ֻ̣߳мĳҲܲչ
+            parallelFor(work[jobCount], minPrimitivesPerThread, threads, [&](size_t begin, size_t end) {
+                size_t i = size_t(upper_bound(work.begin(), work.end(), begin) - work.begin()) - 1;
+                for (; i < jobCount && work[i] < end; i++) {
+                    size_t first = max(begin, work[i]) - work[i];
+                    size_t last = min(end, work[i + 1]) - work[i];
+                    flattenNode(scene, *jobs[i].node, jobs[i].transform, offsets[i], first, last, *geometry);
+                }
+            });
+
+            // ʵֻģ͵ͼԪ任Բֲ棨ĳΪ0ʵûֱ
+            geometry->world = ranges[0];
+            size_t primitiveBase = geometry->world.size();
+            geometry->instances.reserve(scene.instances.size());
+            for (auto& instance : scene.instances) {
+                if (instance.model >= scene.models.size()) continue;
+                auto& range = ranges[modelGroups[instance.model]];
+                if (range.size() == 0 || glm::determinant(instance.linear()) == 0) continue;
+                auto m = instance.matrix();
+                geometry->instances.push_back({range, m, glm::inverse(m), primitiveBase});
+                primitiveBase += range.size();
+            }
+            geometry->instancePrimitives = primitiveBase - geometry->world.size();
+            return geometry;
+        }
+
+        // ȡչļ壬ʰ汾Ŷδ仯ʱϴεĽ
+        static SharedFlatGeometry get(const Scene& scene, unsigned int threads = 0) {
+            static mutex lock;
+            static SceneVersion cachedVersion;
+            static SharedFlatGeometry cached;
+            lock_guard<mutex> guard{lock};
+            auto& version = scene.version;
+            if (version.known() && cached
+                && cachedVersion.geometry == version.geometry
+                && cachedVersion.material == version.material) {
+                return cached;
+            }
+            cached = flatten(scene, threads);
+            cachedVersion = version;
+            return cached;
+        }
+
+    private:
+        // ͼԪ̫ʱ̵߳òʧ
+        static constexpr size_t minPrimitivesPerThread = size_t(1) << 14;
+
+        // 任Ա任ģ͵ţƽƣʵõģʹõλ任
+        struct Transform
+        {
+            Mat3x3 linear{1};
+            Vec3 translation = {0, 0, 0};
+            Mat3x3 normalMatrix{1};     // Բֵʽʽķţתþͬ
+            float radiusScale = 1;      // ź󳤶ȵֵ
+
+            Transform() = default;
+            Transform(const Mat3x3& m, const Vec3& t)
+                : linear            (m)
+                , translation       (t)
+            {
+                // ʽԲ죨ĳΪ0ʱȻж
+                Mat3x3 cofactor{glm::cross(m[1], m[2]), glm::cross(m[2], m[0]), glm::cross(m[0], m[1])};
+                float det = glm::determinant(m);
+                normalMatrix = det < 0 ? -cofactor : cofactor;
+                radiusScale = max(glm::length(m[0]), max(glm::length(m[1]), glm::length(m[2])));
+            }
+
+            Vec3 point(const Vec3& p) const {
+                return linear*p + translation;
+            }
+            Vec3 direction(const Vec3& v) const {
+                return linear*v;
+            }
+            Vec3 normal(const Vec3& n) const {
+                Vec3 r = normalMatrix*n;
+                float len = glm::length(r);
+                return len > 0 ? r / len : n;
+            }
+        };
+
+        // չ
+        struct Job
+        {
+            const Node* node;
+            Transform transform;
+        };
+
+        // չڵĵ[first, last)ͼԪֻڵжͼԪ
+        static void flattenNode(const Scene& scene, const Node& node, const Transform& t, size_t offset,
+                                size_t first, size_t last, FlatGeometry& geometry) {
+            if (node.type == Node::Type::SPHERE) {
+                // Ǿʱȡᣬõס
+                auto s = scene.sphereBuffer[node.entity];
+                s.position = t.point(s.position);
+                s.radius *= t.radiusScale;
+                auto direction = t.direction(s.direction);
+                if (glm::length(direction) > 0) s.direction = glm::normalize(direction);
+                geometry.spheres[offset] = s;
+            }
+            else if (node.type == Node::Type::TRIANGLE) {
+                auto tri = scene.triangleBuffer[node.entity];
+                for (int i = 0; i < 3; i++) {
+                    tri.v[i] = t.point(tri.v[i]);
+                }
+                tri.normal = t.normal(tri.normal);
+                geometry.triangles[offset] = tri;
+            }
+            else if (node.type == Node::Type::PLANE) {
+                auto p = scene.planeBuffer[node.entity];
+                p.position = t.point(p.position);
+                p.u = t.direction(p.u);
+                p.v = t.direction(p.v);
+                p.normal = t.normal(p.normal);
+                geometry.planes[offset] = p;
+            }
+            else if (node.type == Node::Type::MESH && scene.meshBuffer[node.entity]) {
+                // ηȡηߣ㷨ʱת붥㷨֮ͬ
+                auto& mesh = *scene.meshBuffer[node.entity];
+                bool hasNormal = mesh.hasNormal() && mesh.normalIndices.size() == mesh.positionIndices.size();
+                for (size_t f = first; f < last; f++) {
+                    Triangle tri;
+                    tri.material = mesh.material;
+                    Vec3 local[3];
+                    for (int i = 0; i < 3; i++) {
+                        local[i] = mesh.positions[mesh.positionIndices[f*3 + i]];
+                        tri.v[i] = t.point(local[i]);
+                    }
+                    Vec3 n = glm::cross(local[1] - local[0], local[2] - local[0]);
+                    if (hasNormal) {
+                        Vec3 shading = mesh.normals[mesh.normalIndices[f*3]]
+                            + mesh.normals[mesh.normalIndices[f*3 + 1]]
+                            + mesh.normals[mesh.normalIndices[f*3 + 2]];
+                        if (glm::dot(n, shading) < 0) n = -n;
+                    }
+                    tri.normal = t.normal(n);
+                    geometry.triangles[offset + f] = tri;
+                }
+            }
+        }
+    };
+}
+
+#endif
\ No newline at end of file
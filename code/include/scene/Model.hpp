@@ -115,8 +115,49 @@ namespace NRenderer
         vector<Index> nodes;           // ڵб
         Vec3 translation = {0, 0, 0};  // ƽ
         Vec3 scale = {1, 1, 1};       // 
+        bool visible = true;           // ΪfalseʱģȾֻΪʵģ
     };
     SHARE(Model);
+
+    // ģʵ
+    // Լı任ٴηһеģֻͣģ͵Ľڵ뼸壬
+    // ʵı任ֱģ͵ľֲ꣬ȡģƽţţתƽ
+    struct ModelInstance {
+        Index model = 0;                // õģ
+        Vec3 translation = {0, 0, 0};   // ƽ
+        Vec3 rotation = {0, 0, 0};      // XYZתĽǶȣȣ
+        Vec3 scale = {1, 1, 1};         // 
+
+        // ת
+        Mat3x3 rotationMatrix() const {
+            Vec3 r = glm::radians(rotation);
+            float cx = cos(r.x), sx = sin(r.x);
+            float cy = cos(r.y), sy = sin(r.y);
+            float cz = cos(r.z), sz = sin(r.z);
+            // glmд
+            Mat3x3 rx{1, 0, 0,  0, cx, sx,  0, -sx, cx};
+            Mat3x3 ry{cy, 0, -sy,  0, 1, 0,  sy, 0, cy};
+            Mat3x3 rz{cz, sz, 0,  -sz, cz, 0,  0, 0, 1};
+            return rz*ry*rx;
+        }
+
+        // 任Բ֣תţ
+        Mat3x3 linear() const {
+            Mat3x3 s{1};
+            s[0][0] = scale.x;
+            s[1][1] = scale.y;
+            s[2][2] = scale.z;
+            return rotationMatrix()*s;
+        }
+
+        // α任
+        Mat4x4 matrix() const {
+            Mat4x4 m{linear()};
+            m[3] = Vec4{translation, 1};
+            return m;
+        }
+    };
+    SHARE(ModelInstance);
 }
 
 #endif
\ No newline at end of file
@@ -12,15 +12,35 @@ namespace NRenderer
 {
     struct RenderOption
     {
+        enum class SamplerType
+        {
+            RANDOM, HALTON, SOBOL
+        };
         unsigned int width;
         unsigned int height;
         unsigned int depth;
         unsigned int samplesPerPixel;
+        bool progressive;               // ʽȾֲֶÿֺˢĻ
+        unsigned int samplesPerPass;    // ʽȾÿֵÿز
+        bool adaptiveSampling;          // Ӧֻϴ
+        float adaptiveThreshold;        // Ӧֵ
+        unsigned int threads;           // Ⱦ߳0ʾʹӲ
+        SamplerType sampler;            // 
+        unsigned int seed;              // ӣͬӵõͬȾ
+        bool denoise;                   // ȾǷ
         RenderOption()
             : width             (500)
             , height            (500)
             , depth             (4)
             , samplesPerPixel   (16)
+            , progressive       (false)
+            , samplesPerPass    (1)
+            , adaptiveSampling  (false)
+            , adaptiveThreshold (0.02f)
+            , threads           (0)
+            , sampler           (SamplerType::SOBOL)
+            , seed              (0)
+            , denoise           (false)
         {}
     };
 
@@ -35,10 +55,27 @@ namespace NRenderer
         Handle environmentMap = {};
     };
 
+    // ݵİ汾ţʲİ汾Ÿƶ
+    // Ⱦĳһ汾ͬ˵δ޸ģȾԸõ
+    // Ϊ0ʾԴδ֪ܸ
+    struct SceneVersion
+    {
+        uint64_t geometry = 0;      // ģͱ任
+        uint64_t material = 0;      // ʼĲʰ
+        uint64_t texture = 0;       // 
+        uint64_t light = 0;         // Դ
+
+        bool known() const {
+            return geometry != 0 && material != 0 && texture != 0 && light != 0;
+        }
+    };
+
     struct Scene
     {
         Camera camera;
 
+        SceneVersion version;
+
         RenderOption renderOption;
 
         Ambient ambient;
@@ -49,11 +86,14 @@ namespace NRenderer
 
         vector<Model> models;
         vector<Node> nodes;
+        // ģʵֻ¼任õģ͹
+        vector<ModelInstance> instances;
         // object buffer
         vector<Sphere> sphereBuffer;
         vector<Triangle> triangleBuffer;
         vector<Plane> planeBuffer;
-        vector<Mesh> meshBuffer;
+        // 񶥵󣬳ֻʲеĲɱ񣬲
+        vector<shared_ptr<const Mesh>> meshBuffer;
 
         vector<Light> lights;
         // light buffer
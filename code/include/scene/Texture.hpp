@@ -3,18 +3,165 @@
 #define __NR_TEXTURE_HPP__
 
 #include <memory>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 
 #include "geometry/vec.hpp"
 
+// x64뿪SSE2x86֧SSE2ʱת뾫ȸʱÿδ8
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NR_TEXTURE_SSE2
+#endif
+
 namespace NRenderer
 {
     using namespace std;
+
+    // ȸת뾫ȸͽ룩
+    inline uint16_t floatToHalf(float f) {
+        uint32_t x;
+        memcpy(&x, &f, 4);
+        uint32_t sign = (x >> 16) & 0x8000u;
+        uint32_t absX = x & 0x7fffffffu;
+        if (absX >= 0x7f800000u) {
+            // InfNaN
+            return uint16_t(sign | 0x7c00u | (absX > 0x7f800000u ? 0x200u : 0u));
+        }
+        if (absX >= 0x477ff000u) {
+            // 뾫ȷΧ
+            return uint16_t(sign | 0x7c00u);
+        }
+        if (absX < 0x38800000u) {
+            // 뾫ȷǹ
+            if (absX < 0x33000000u) return uint16_t(sign);
+            uint32_t mantissa = (absX & 0x7fffffu) | 0x800000u;
+            int shift = 126 - int(absX >> 23);
+            uint32_t half = mantissa >> shift;
+            uint32_t rest = mantissa & ((1u << shift) - 1);
+            uint32_t halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1u))) half++;
+            return uint16_t(sign | half);
+        }
+        uint32_t half = ((absX - 0x38000000u) >> 13);
+        uint32_t rest = absX & 0x1fffu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) half++;
+        return uint16_t(sign | half);
+    }
+
+#ifdef NR_TEXTURE_SSE2
+    // 4ȸת뾫ȸڸ32λĵ16λfloatToHalfͬ
+    // ĸ16λȫΪ1ֱ_mm_packs_epi32
+    inline __m128i floatToHalf4(__m128 f) {
+        const __m128i infinity = _mm_set1_epi32(0x7c00);
+        const __m128i nanBit = _mm_set1_epi32(0x200);
+        const __m128i maxHalf = _mm_set1_epi32(0x477ff000);             // СڴֵΪInf
+        const __m128i minNormal = _mm_set1_epi32(0x38800000);           // СڴֵΪǹ
+        const __m128i subnormalMagic = _mm_set1_epi32(0x3f000000);      // 0.5ϺβĵλΪĽ
+        const __m128i normalBias = _mm_set1_epi32(0xfff - 0x38000000);  // ָƫ
+
+        __m128 sign = _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(int(0x80000000u))));
+        __m128 absF = _mm_xor_ps(f, sign);
+        __m128i absBits = _mm_castps_si128(absF);
+
+        // InfNaNԼΧ
+        __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+        __m128i special = _mm_or_si128(infinity, _mm_and_si128(isNan, nanBit));
+        __m128i isRegular = _mm_cmpgt_epi32(maxHalf, absBits);
+
+        // ǹȼӷɾͽ
+        __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absBits);
+        __m128 subnormalSum = _mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic));
+        __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalSum), subnormalMagic);
+
+        // βضǰ0xfffλΪʱټ1ʵ־ͽ뵽ż
+        __m128i odd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+        __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), odd), 13);
+
+        __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+        __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+        return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+#endif
+
+    // תΪ뾫ȸ
+    // src: countȸ
+    // dst: count*2ֽ
+    inline void floatToHalf(const float* src, unsigned char* dst, size_t count) {
+        size_t i = 0;
+#ifdef NR_TEXTURE_SSE2
+        for (; i + 8 <= count; i += 8) {
+            __m128i lo = floatToHalf4(_mm_loadu_ps(src + i));
+            __m128i hi = floatToHalf4(_mm_loadu_ps(src + i + 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*2), _mm_packs_epi32(lo, hi));
+        }
+#endif
+        for (; i < count; i++) {
+            uint16_t v = floatToHalf(src[i]);
+            memcpy(dst + i*2, &v, 2);
+        }
+    }
+
+    // 뾫ȸתȸ
+    inline float halfToFloat(uint16_t h) {
+        uint32_t sign = uint32_t(h & 0x8000u) << 16;
+        uint32_t exponent = (h >> 10) & 0x1fu;
+        uint32_t mantissa = h & 0x3ffu;
+        uint32_t x;
+        if (exponent == 0) {
+            if (mantissa == 0) {
+                x = sign;
+            }
+            else {
+                // ǹ񻯺ת
+                exponent = 113;
+                while ((mantissa & 0x400u) == 0) {
+                    mantissa <<= 1;
+                    exponent--;
+                }
+                x = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+            }
+        }
+        else if (exponent == 31) {
+            x = sign | 0x7f800000u | (mantissa << 13);
+        }
+        else {
+            x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        float f;
+        memcpy(&f, &x, 4);
+        return f;
+    }
+
+    // ༶Զеһذĸʽ
+    struct MipLevel
+    {
+        unsigned int width;
+        unsigned int height;
+        vector<unsigned char> data;
+    };
+
+    // 
+    // RGBA8RGBA16Fʽ༶ԶǲɱĹ飬
+    // SceneBuilderʱֻü޸ʱ滻飨дʱƣ
     struct Texture
     {
+        // ش洢ʽ
+        enum class Format
+        {
+            RGBA32F,    // ÿ16ֽڣrgba
+            RGBA8,      // ÿ4ֽڣֵΪ[0,255]/255packed
+            RGBA16F     // ÿ8ֽڵİ뾫ȸHDRͼpacked
+        };
+
         Texture()
             : height(0)
             , width(0)
             , rgba(nullptr)
+            , format(Format::RGBA32F)
         {}
         ~Texture() {
             delete[]  rgba;
@@ -22,20 +169,210 @@ namespace NRenderer
         Texture(const Texture& texture) {
             this->height = texture.height;
             this->width = texture.width;
-            this->rgba = new RGBA[texture.height*texture.width];
-            for (int i = 0; i < texture.height*texture.width; i++) {
-                this->rgba[i] = texture.rgba[i];
+            this->rgba = nullptr;
+            if (texture.rgba != nullptr) {
+                this->rgba = new RGBA[texture.height*texture.width];
+                for (int i = 0; i < texture.height*texture.width; i++) {
+                    this->rgba[i] = texture.rgba[i];
+                }
             }
+            this->format = texture.format;
+            this->packed = texture.packed;
+            this->mipmaps = texture.mipmaps;
         }
         Texture(Texture&& texture) noexcept {
             this->height = texture.height;
             this->width = texture.width;
             this->rgba = texture.rgba;
+            this->format = texture.format;
+            this->packed = move(texture.packed);
+            this->mipmaps = move(texture.mipmaps);
             texture.rgba = nullptr;
         }
         unsigned int height;
         unsigned int width;
         RGBA* rgba;
+        Format format;
+        // RGBA8RGBA16Fʽ0
+        shared_ptr<const vector<unsigned char>> packed;
+        // 1ĸСͼδʱΪ
+        shared_ptr<const vector<MipLevel>> mipmaps;
+
+        // ÿֽ
+        static size_t bytesPerTexel(Format f) {
+            return f == Format::RGBA32F ? 16 : (f == Format::RGBA8 ? 4 : 8);
+        }
+
+        // 8λdataΪwidth*height*4ֽ
+        void setRGBA8(unsigned int w, unsigned int h, const unsigned char* data) {
+            delete[] rgba;
+            rgba = nullptr;
+            width = w;
+            height = h;
+            format = Format::RGBA8;
+            packed = make_shared<const vector<unsigned char>>(data, data + size_t(w)*h*4);
+            mipmaps.reset();
+        }
+
+        // ԰뾫ȸHDRݣdataΪwidth*height*4
+        void setRGBA16F(unsigned int w, unsigned int h, const float* data) {
+            delete[] rgba;
+            rgba = nullptr;
+            width = w;
+            height = h;
+            format = Format::RGBA16F;
+            auto block = make_shared<vector<unsigned char>>(size_t(w)*h*8);
+            floatToHalf(data, block->data(), size_t(w)*h*4);
+            packed = move(block);
+            mipmaps.reset();
+        }
+
+        // Ƿû
+        bool empty() const {
+            if (width == 0 || height == 0) return true;
+            return format == Format::RGBA32F ? rgba == nullptr : (packed == nullptr || packed->empty());
+        }
+
+        // ռõֽ༶Զ
+        size_t memorySize() const {
+            size_t size = size_t(width)*height*bytesPerTexel(format);
+            if (mipmaps) {
+                for (auto& level : *mipmaps) size += level.data.size();
+            }
+            return size;
+        }
+
+        // 0
+        unsigned int levels() const {
+            return 1 + (mipmaps ? unsigned(mipmaps->size()) : 0u);
+        }
+
+        // ɶ༶Զÿһ2x2ƽõߴʱԵظʹ
+        void generateMipmaps() {
+            mipmaps.reset();
+            if (empty()) return;
+            // µһɵһõɹȹmipmapsϹtexelȡ
+            auto chain = make_shared<vector<MipLevel>>();
+            mipmaps = chain;
+            unsigned int w = width;
+            unsigned int h = height;
+            size_t texelBytes = bytesPerTexel(format);
+            while (w > 1 || h > 1) {
+                unsigned int level = levels() - 1;
+                MipLevel next{ max(w/2, 1u), max(h/2, 1u), {} };
+                next.data.resize(size_t(next.width)*next.height*texelBytes);
+                if (format == Format::RGBA8) {
+                    // 8λֱӰƽ(a+b+c+d+2)/4Ϊƽľͽ
+                    const unsigned char* src = level == 0 ? packed->data() : (*chain)[level - 1].data.data();
+                    downsampleRGBA8(src, w, h, next);
+                }
+                else for (unsigned int y = 0; y < next.height; y++) {
+                    unsigned int y0 = min(2*y, h - 1), y1 = min(2*y + 1, h - 1);
+                    for (unsigned int x = 0; x < next.width; x++) {
+                        unsigned int x0 = min(2*x, w - 1), x1 = min(2*x + 1, w - 1);
+                        RGBA c = (texel(level, x0, y0) + texel(level, x1, y0)
+                            + texel(level, x0, y1) + texel(level, x1, y1)) * 0.25f;
+                        encode(c, &next.data[(size_t(y)*next.width + x)*texelBytes]);
+                    }
+                }
+                chain->push_back(move(next));
+                w = chain->back().width;
+                h = chain->back().height;
+            }
+        }
+
+        // ȡĳһأ갴ظʽ
+        RGBA texel(unsigned int level, int x, int y) const {
+            unsigned int w = level == 0 ? width : (*mipmaps)[level - 1].width;
+            unsigned int h = level == 0 ? height : (*mipmaps)[level - 1].height;
+            x = ((x % int(w)) + int(w)) % int(w);
+            y = ((y % int(h)) + int(h)) % int(h);
+            size_t index = size_t(y)*w + x;
+            if (level == 0 && format == Format::RGBA32F) return rgba[index];
+            const unsigned char* data = level == 0 ? packed->data() : (*mipmaps)[level - 1].data.data();
+            return decode(data + index*bytesPerTexel(format));
+        }
+
+        // ĳһϵ˫Բֵuv[0,1)ڣv=0Ӧһ
+        RGBA sampleLevel(const Vec2& uv, unsigned int level) const {
+            unsigned int w = level == 0 ? width : (*mipmaps)[level - 1].width;
+            unsigned int h = level == 0 ? height : (*mipmaps)[level - 1].height;
+            float fx = uv.x * float(w) - 0.5f;
+            float fy = uv.y * float(h) - 0.5f;
+            int x = int(floor(fx));
+            int y = int(floor(fy));
+            float tx = fx - float(x);
+            float ty = fy - float(y);
+            return (texel(level, x, y)*(1 - tx) + texel(level, x + 1, y)*tx)*(1 - ty)
+                + (texel(level, x, y + 1)*(1 - tx) + texel(level, x + 1, y + 1)*tx)*ty;
+        }
+
+        // Բ
+        // lod: ϸڼ0Ϊԭͼÿ1ߴ룻ɵļʱȡֵһ
+        RGBA sample(const Vec2& uv, float lod) const {
+            if (empty()) return RGBA{0};
+            float maxLevel = float(levels() - 1);
+            lod = glm::clamp(lod, 0.f, maxLevel);
+            unsigned int l0 = unsigned(lod);
+            unsigned int l1 = min(l0 + 1, levels() - 1);
+            float t = lod - float(l0);
+            if (t <= 0.f || l0 == l1) return sampleLevel(uv, l0);
+            return sampleLevel(uv, l0)*(1 - t) + sampleLevel(uv, l1)*t;
+        }
+
+    private:
+        // 8λ2x2ʽСߴʱԵظʹ
+        static void downsampleRGBA8(const unsigned char* src, unsigned int w, unsigned int h, MipLevel& next) {
+            for (unsigned int y = 0; y < next.height; y++) {
+                const unsigned char* row0 = src + size_t(min(2*y, h - 1))*w*4;
+                const unsigned char* row1 = src + size_t(min(2*y + 1, h - 1))*w*4;
+                unsigned char* out = next.data.data() + size_t(y)*next.width*4;
+                // ڲжͼڣֽڴڱ
+                unsigned int pairs = min(next.width, w/2);
+                for (size_t i = 0; i < size_t(pairs)*4; i++) {
+                    size_t a = (i/4)*8 + i%4;
+                    out[i] = (unsigned char)((row0[a] + row0[a + 4] + row1[a] + row1[a + 4] + 2) >> 2);
+                }
+                for (unsigned int x = pairs; x < next.width; x++) {
+                    unsigned int x0 = min(2*x, w - 1), x1 = min(2*x + 1, w - 1);
+                    for (int c = 0; c < 4; c++) {
+                        out[x*4 + c] = (unsigned char)((row0[x0*4 + c] + row0[x1*4 + c] + row1[x0*4 + c] + row1[x1*4 + c] + 2) >> 2);
+                    }
+                }
+            }
+        }
+
+        // ǰʽһ
+        RGBA decode(const unsigned char* p) const {
+            if (format == Format::RGBA8) {
+                constexpr float inv = 1.f / 255.f;
+                return { p[0]*inv, p[1]*inv, p[2]*inv, p[3]*inv };
+            }
+            if (format == Format::RGBA16F) {
+                uint16_t h[4];
+                memcpy(h, p, 8);
+                return { halfToFloat(h[0]), halfToFloat(h[1]), halfToFloat(h[2]), halfToFloat(h[3]) };
+            }
+            RGBA c;
+            memcpy(&c, p, sizeof(RGBA));
+            return c;
+        }
+
+        // ǰʽһ
+        void encode(const RGBA& c, unsigned char* p) const {
+            if (format == Format::RGBA8) {
+                for (int i = 0; i < 4; i++) {
+                    p[i] = (unsigned char)(glm::clamp(c[i], 0.f, 1.f)*255.f + 0.5f);
+                }
+            }
+            else if (format == Format::RGBA16F) {
+                uint16_t h[4] = { floatToHalf(c.r), floatToHalf(c.g), floatToHalf(c.b), floatToHalf(c.a) };
+                memcpy(p, h, 8);
+            }
+            else {
+                memcpy(p, &c, sizeof(RGBA));
+            }
+        }
     };
     using SharedTexture = shared_ptr<Texture>;
 }
@@ -0,0 +1,101 @@
+// ֡ඨ
+// ԾͨȾ丨AOV
+#pragma once
+#ifndef __NR_FRAMEBUFFER_HPP__
+#define __NR_FRAMEBUFFER_HPP__
+
+#include "geometry/vec.hpp"
+#include <vector>
+
+namespace NRenderer
+{
+    using namespace std;
+
+    // ֡
+    // ÿͨwidth*heightصĸ飬ȡ϶
+    // ͨ䣬ȾֻдԼṩͨ
+    class Framebuffer
+    {
+    public:
+        // ͨ
+        enum class Channel
+        {
+            BEAUTY,         // Կռɫ3
+            ALBEDO,         // һཻķʣ3
+            NORMAL,         // һཻķߣ3
+            DEPTH,          // һཻ룬δΪ01
+            MATERIAL_ID,    // һཻĲ±꣬δΪ-11
+            PRIMITIVE_ID,   // һཻͼԪ±꣬δΪ-11
+            SAMPLE_COUNT,   // ÿز1
+            VARIANCE        // ؾֵȷ1
+        };
+        constexpr static unsigned int channelCount = 8;
+
+    private:
+        unsigned int width;
+        unsigned int height;
+        vector<float> channels[channelCount];
+
+    public:
+        Framebuffer(unsigned int width = 0, unsigned int height = 0)
+            : width             (width)
+            , height            (height)
+        {}
+
+        // ȡͨ
+        static const char* channelName(Channel c) {
+            constexpr static const char* names[channelCount] = {
+                "Beauty", "Albedo", "Normal", "Depth", "Material ID", "Primitive ID", "Sample Count", "Variance"
+            };
+            return names[unsigned(c)];
+        }
+
+        // ȡͨÿصķ
+        static unsigned int channelComponents(Channel c) {
+            return c == Channel::BEAUTY || c == Channel::ALBEDO || c == Channel::NORMAL ? 3 : 1;
+        }
+
+        unsigned int getWidth() const { return width; }
+        unsigned int getHeight() const { return height; }
+
+        // ֵָͨʼѴʱ³ʼ
+        void add(Channel c, float value = 0.f) {
+            channels[unsigned(c)].assign(size_t(width)*height*channelComponents(c), value);
+        }
+
+        // ͨǷ
+        bool has(Channel c) const {
+            return !channels[unsigned(c)].empty();
+        }
+
+        // ȡͨ
+        vector<float>& data(Channel c) { return channels[unsigned(c)]; }
+        const vector<float>& data(Channel c) const { return channels[unsigned(c)]; }
+
+        // дͨ
+        void set(Channel c, unsigned int index, const Vec3& v) {
+            auto& d = channels[unsigned(c)];
+            d[index*3] = v.x;
+            d[index*3 + 1] = v.y;
+            d[index*3 + 2] = v.z;
+        }
+
+        // д뵥ͨ
+        void set(Channel c, unsigned int index, float v) {
+            channels[unsigned(c)][index] = v;
+        }
+
+        // ȡͨ
+        Vec3 getVec3(Channel c, unsigned int index) const {
+            auto& d = channels[unsigned(c)];
+            return { d[index*3], d[index*3 + 1], d[index*3 + 2] };
+        }
+
+        // ȡͨ
+        float get(Channel c, unsigned int index) const {
+            return channels[unsigned(c)][index];
+        }
+    };
+} // namespace NRenderer
+
+#endif
\ No newline at end of file
@@ -6,7 +6,10 @@
 
 #include "geometry/vec.hpp"
 #include "common/macros.hpp"
+#include "Framebuffer.hpp"
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace NRenderer
 {
@@ -19,6 +22,7 @@ namespace NRenderer
         unsigned int width;     // Ļ
         unsigned int height;    // Ļ߶
         mutable bool updated;   // ±־
+        Framebuffer framebuffer;// ȾṩAOVͨ
         mutable mutex mtx;      // ֤̰߳ȫ
 
     public:
@@ -37,12 +41,23 @@ namespace NRenderer
         unsigned int getWidth() const;
         // ȡĻ߶
         unsigned int getHeight() const;
-        // ȡ
-        const RGBA* getPixels() const;
+        // ȡݵĿ
+        // ߴͬһμжȡȾ߳ĻӰ췵ص
+        vector<RGBA> getPixels(unsigned int& width, unsigned int& height) const;
         // ͷػ
         void release();
         // Ƿи
         bool isUpdated() const;
+
+        // ֡
+        // Ⱦĸͨʾļ
+        void setFramebuffer(const Framebuffer& framebuffer);
+        // ȡ֡Ŀ
+        Framebuffer getFramebuffer() const;
+        // ֡Ƿָͨ
+        bool hasChannel(Framebuffer::Channel channel) const;
+        // ͨΪPFMļǷɹ
+        bool saveChannel(Framebuffer::Channel channel, const std::string& path) const;
     };  
 } // namespace NRenderer
 
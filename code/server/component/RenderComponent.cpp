@@ -3,8 +3,17 @@
 namespace NRenderer
 {
     void RenderComponent::exec(function<void()> onStart, function<void()> onFinish, SharedScene spScene) {
+        stopRequested = false;
         onStart();
         render(spScene);
         onFinish();
     }
+
+    void RenderComponent::requestStop() {
+        stopRequested = true;
+    }
+
+    bool RenderComponent::isStopRequested() const {
+        return stopRequested;
+    }
 } // namespace Renderer
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Server/Screen.hpp"
 
 #include <cstdlib>
+#include <cstdio>
 
 namespace NRenderer
 {
@@ -45,11 +46,15 @@ namespace NRenderer
         mtx.unlock();
         return h;
     }
-    const RGBA* Screen::getPixels() const {
+    vector<RGBA> Screen::getPixels(unsigned int& width, unsigned int& height) const {
         mtx.lock();
         updated = false;
+        // 缓冲区已释放时返回空的图像
+        width = pixels != nullptr ? this->width : 0;
+        height = pixels != nullptr ? this->height : 0;
+        vector<RGBA> copy(pixels, pixels + width*height);
         mtx.unlock();
-        return pixels;
+        return copy;
     }
     void Screen::set(RGBA* pixels, int width, int height) {
         mtx.lock();
@@ -64,4 +69,38 @@ namespace NRenderer
         }
         mtx.unlock();
     }
+    void Screen::setFramebuffer(const Framebuffer& framebuffer) {
+        mtx.lock();
+        this->framebuffer = framebuffer;
+        mtx.unlock();
+    }
+    Framebuffer Screen::getFramebuffer() const {
+        mtx.lock();
+        auto fb = framebuffer;
+        mtx.unlock();
+        return fb;
+    }
+    bool Screen::hasChannel(Framebuffer::Channel channel) const {
+        mtx.lock();
+        bool has = framebuffer.has(channel);
+        mtx.unlock();
+        return has;
+    }
+    bool Screen::saveChannel(Framebuffer::Channel channel, const std::string& path) const {
+        auto fb = getFramebuffer();
+        if (!fb.has(channel)) return false;
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (fp == nullptr) return false;
+        auto components = Framebuffer::channelComponents(channel);
+        auto w = fb.getWidth();
+        auto h = fb.getHeight();
+        fprintf(fp, "%s\n%u %u\n-1.0\n", components == 3 ? "PF" : "Pf", w, h);
+        auto& data = fb.data(channel);
+        for (unsigned int i=0; i<h; i++) {
+            auto row = &data[size_t(h-i-1)*w*components];
+            fwrite(row, sizeof(float), size_t(w)*components, fp);
+        }
+        fclose(fp);
+        return true;
+    }
 } // namespace NRenderer